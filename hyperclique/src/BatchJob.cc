@@ -0,0 +1,153 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "BatchJob.h"
+#include "Constants.h"
+#include "MappedFile.h"
+#include "Decompressor.h"
+#include "Snapshot.h"
+
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cstring>
+
+bool BatchJob::read(const string &jobFile, const BatchJob &defaults, vector<BatchJob> &jobs, string &error)
+{
+  ifstream in(jobFile.c_str());
+  if (!in)
+  {
+    error = "cannot read the job file " + jobFile;
+    return false;
+  }
+
+  unsigned int lineNumber = 0;
+  for (string line; getline(in, line);)
+  {
+    lineNumber++;
+    istringstream tokens(line);
+    string token;
+    if (!(tokens >> token) || token[0] == '#')
+      continue;
+
+    BatchJob job = defaults;
+    job.file = token;
+    job.cost = 0;
+    bool methods = false;
+    while (tokens >> token)
+    {
+      if (token.size() < 2 || token[0] != '-')
+        token = "";
+      else if (token.size() == 2 && strchr("abcu", token[1]) != NULL)
+      {
+        // The methods of the line replace the ones of the command line
+        if (!methods)
+          job.hbk = job.ce = job.ce_hbk = job.nu_hbk = false;
+        methods = true;
+        job.hbk |= (token[1] == 'a');
+        job.ce |= (token[1] == 'b');
+        job.ce_hbk |= (token[1] == 'c');
+        job.nu_hbk |= (token[1] == 'u');
+        continue;
+      }
+
+      switch (token.empty() ? 0 : token[1])
+      {
+      case 'o':
+        job.orderingValue = atoi(token.c_str() + 2);
+        continue;
+      case 'f':
+        job.filteringValue = atoi(token.c_str() + 2);
+        continue;
+      case 'n':
+        job.nodeFilteringValue = atoi(token.c_str() + 2);
+        continue;
+      case 'P':
+        job.pivotValue = atoi(token.c_str() + 2);
+        continue;
+      case 't':
+        if (token.size() == 2 && tokens >> token)
+        {
+          job.timer = atof(token.c_str());
+          continue;
+        }
+        break;
+      }
+
+      error = "unexpected \"" + token + "\" line " + to_string(lineNumber) + " of " + jobFile;
+      return false;
+    }
+    jobs.push_back(job);
+  }
+  return true;
+}
+
+void BatchJob::predictCost()
+{
+  unsigned long nbVertices = 0, nbEdges = 0, maxRank = 0;
+
+  MappedFile mapped;
+  if (!mapped.open(file))
+    return;
+
+  if (Snapshot::isSnapshot(mapped.begin(), mapped.end()))
+  {
+    Snapshot snapshot(mapped.begin(), mapped.end());
+    if (snapshot.valid)
+    {
+      nbVertices = snapshot.header->nbVertices;
+      nbEdges = snapshot.header->nbEdges;
+      maxRank = snapshot.header->biggestHyperedge;
+    }
+  }
+  else
+  {
+    Decompressor input(mapped.begin(), mapped.end(), Decompressor::compression(mapped.begin(), mapped.end()));
+    if (!input.valid)
+      return;
+
+    vector<char> sample(PREDICTION_SAMPLE);
+    sample.resize(input.sgetn(sample.data(), sample.size()));
+
+    istringstream lines(string(sample.begin(), sample.end()));
+    for (string line; getline(lines, line);)
+    {
+      istringstream tokens(line);
+      string token;
+      if (!(tokens >> token) || token == "c")
+        continue;
+
+      if (token == "p")
+        tokens >> token >> nbVertices >> nbEdges;
+      else
+      {
+        // The id of a hyperedge, or the final 0 of a clause, is not a vertex
+        unsigned long rank = 0;
+        while (tokens >> token)
+          rank++;
+        if (rank > maxRank)
+          maxRank = rank;
+      }
+    }
+  }
+
+  cost = (double)nbEdges * maxRank + nbVertices;
+}
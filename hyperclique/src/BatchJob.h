@@ -0,0 +1,63 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef BATCH_JOB_H
+#define BATCH_JOB_H
+
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * One line of a job file: an instance and the options to run it with.
+ *
+ * A line is the path of the instance followed by any of `-a`, `-b`, `-c`, `-u`, `-o<i>`, `-f<i>`,
+ * `-n<i>`, `-P<i>` and `-t <s>`; the options that are not given are the ones of the command line.
+ * Blank lines and lines starting with `#` are ignored.
+ */
+struct BatchJob
+{
+  string file;
+  bool hbk, ce, ce_hbk, nu_hbk;
+  unsigned int orderingValue;
+  unsigned int filteringValue;
+  unsigned int nodeFilteringValue;
+  unsigned int pivotValue;
+  double timer;
+
+  /** The predicted cost of the job, the longest jobs are started first. */
+  double cost;
+
+  /**
+   * Reads the jobs of `jobFile`, completing each line with `defaults`.
+   * Returns `false` and sets `error` if the file cannot be read or a line is malformed.
+   */
+  static bool read(const string &jobFile, const BatchJob &defaults, vector<BatchJob> &jobs, string &error);
+
+  /**
+   * Predicts the cost of the job from the size of its instance: the number of nodes and hyperedges
+   * of the problem line (or snapshot header), and the max rank of the first hyperedges.
+   * Only the beginning of the file is read (decompressed if needed).
+   */
+  void predictCost();
+};
+
+#endif // BATCH_JOB_H
@@ -27,232 +27,342 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include <random>    // default_random_engine
 #include <chrono>    // chrono::system_clock
 
-set<set<vertex_t>> BronKerbosch::cliques;
-set<vertex_t> BronKerbosch::biggestClique;
+CliqueStore BronKerbosch::cliques;
+clique_t BronKerbosch::biggestClique;
 unsigned int BronKerbosch::nbCallToBK = 0;
 
-void BronKerbosch::findHypercliques(set<vertex_t> clique, set<vertex_t, MyComparator> candidates,
-                                    set<vertex_t> excluded, SweetHBK::Graph *graph)
+void BronKerbosch::mark(Frame &frame, HBKGraph *rank)
+{
+  size_t words = rank->bitRowWords();
+  frame.marked = words > 0;
+  if (!frame.marked)
+    return;
+  // The vertices in no hyperedge may be beyond the rows
+  if (!frame.candidates.empty())
+    words = max(words, (size_t)frame.candidates.back() / 64 + 1);
+  if (!frame.excluded.empty())
+    words = max(words, (size_t)frame.excluded.back() / 64 + 1);
+  if (frame.candidateBits.size() < words)
+  {
+    frame.candidateBits.resize(words, 0);
+    frame.excludedBits.resize(words, 0);
+  }
+  for (const vertex_t v : frame.candidates)
+    frame.candidateBits[v / 64] |= (uint64_t)1 << (v % 64);
+  for (const vertex_t v : frame.excluded)
+    frame.excludedBits[v / 64] |= (uint64_t)1 << (v % 64);
+}
+
+void BronKerbosch::unmark(Frame &frame)
+{
+  if (!frame.marked)
+    return;
+  for (const vertex_t v : frame.candidates)
+    frame.candidateBits[v / 64] = 0;
+  for (const vertex_t v : frame.excluded)
+    frame.excludedBits[v / 64] = 0;
+  frame.marked = false;
+}
+
+void BronKerbosch::branches(Frame &frame, SweetHBK::Graph *graph, bool hyper)
+{
+  SortedRange<vertex_t> candidates(frame.candidates);
+  if (Globals::pivotValue == NO_PIVOT || candidates.size() < 2)
+  {
+    frame.branches.assign(candidates.begin(), candidates.end());
+    return;
+  }
+
+  HBKGraph *rank = graph->gillesCoeurCoeur;
+  auto redundant = [&](vertex_t pivot, vector<vertex_t> &result)
+  {
+    if (hyper)
+      rank->completedBy(frame.clique, candidates, pivot, result);
+    else
+      rank->neighborsIn(candidates, pivot, result);
+  };
+
+  frame.skipped.clear();
+  if (Globals::pivotValue == DEGREE_PIVOT)
+  {
+    vertex_t pivot = 0;
+    size_t degree = 0;
+    for (const vector<vertex_t> *vertices : {&frame.candidates, &frame.excluded})
+    {
+      for (const vertex_t u : *vertices)
+      {
+        size_t d = rank->neighbors(u).size();
+        if (!pivot || d > degree)
+        {
+          pivot = u;
+          degree = d;
+        }
+      }
+    }
+    redundant(pivot, frame.skipped);
+  }
+  else
+  {
+    /* The neighbours of a vertex among the candidates bound the candidates it makes redundant:
+       the vertices are tried from the greatest bound, until none can do better. */
+    frame.bounds.clear();
+    for (const vector<vertex_t> *vertices : {&frame.candidates, &frame.excluded})
+    {
+      for (const vertex_t u : *vertices)
+        frame.bounds.emplace_back(rank->countNeighborsIn(candidates, u), u);
+    }
+    sort(frame.bounds.begin(), frame.bounds.end(), [](const pair<size_t, vertex_t> &a, const pair<size_t, vertex_t> &b)
+         { return a.first > b.first || (a.first == b.first && a.second < b.second); });
+    for (const pair<size_t, vertex_t> &bound : frame.bounds)
+    {
+      if (bound.first <= frame.skipped.size())
+        break;
+      redundant(bound.second, frame.redundant);
+      if (frame.redundant.size() > frame.skipped.size())
+        frame.skipped.swap(frame.redundant);
+    }
+  }
+
+  if (Globals::verbose)
+    cout << "c | *** pivot skips " << frame.skipped.size() << " of " << candidates.size() << " candidates" << endl;
+  Utils::set_difference(candidates, frame.skipped, frame.branches);
+}
+
+void BronKerbosch::findHypercliques(const clique_t &clique, const set<vertex_t> &candidates,
+                                    const set<vertex_t> &excluded, SweetHBK::Graph *graph)
+{
+  Frames frames(1);
+  frames[0].assign(clique, candidates, excluded);
+  findHypercliques(frames, 0, graph);
+}
+
+void BronKerbosch::findHypercliques(Frames &frames, size_t depth, SweetHBK::Graph *graph)
 {
   nbCallToBK++;
 
+  Frame &frame = frames[depth];
   if (Globals::verbose)
-    Utils::printCurrentState(clique, candidates, excluded);
-  if (clique.size() + candidates.size() < graph->gillesCoeurCoeur->laurent)
+    Utils::printCurrentState(frame.clique, SortedRange<vertex_t>(frame.candidates), SortedRange<vertex_t>(frame.excluded));
+  if (frame.clique.size() + frame.candidates.size() < graph->gillesCoeurCoeur->laurent)
     return;
 
-  if (candidates.empty() && excluded.empty())
+  if (frame.candidates.empty() && frame.excluded.empty())
   {
-    cliqueFound(clique);
+    cliqueFound(frame.clique);
   }
 
-  set<vertex_t, MyComparator> new_candidates = candidates;
-  set<vertex_t, MyComparator>::iterator v = new_candidates.begin();
+  branches(frame, graph, true);
+  frame.excluded.reserve(frame.excluded.size() + frame.candidates.size());
+  Frame &next = nextFrame(frames, depth);
 
-  while (!new_candidates.empty() && v != new_candidates.end() && !Globals::timedout)
+  for (const vertex_t v : frame.branches)
   {
+    if (Globals::timedout)
+      break;
     if (Globals::verbose)
-      cout << "c | *** try with " << *v << endl;
-    set<vertex_t> singleton;
-    singleton.insert(*v);
+      cout << "c | *** try with " << v << endl;
+    next.clique = frame.clique;
+    next.clique.insert(v);
 
-    set<vertex_t, MyComparator> ordSingleton(graph->comp);
-    ordSingleton.insert(*v);
-
-    set<vertex_t> cliqueNeighbourhood;
-    set<vertex_t, MyComparator> ordCliqueNeighbourhood(graph->comp);
-    set<vertex_t> newClique = Utils::set_union(clique, singleton);
-    set<vertex_t, MyComparator> diff = Utils::set_difference(candidates, ordSingleton, graph->comp);
-    set<vertex_t, MyComparator> suburbs = Utils::set_union(diff, excluded, graph->comp);
+    // The suburbs are the candidates but `v`, and the excluded vertices
+    Utils::set_union(frame.candidates, frame.excluded, frame.suburbs);
+    frame.suburbs.erase(lower_bound(frame.suburbs.begin(), frame.suburbs.end(), v));
 
     switch (Globals::filteringValue)
     {
     case BLOOM_FILTER:
-      graph->candidateBloomFilter(newClique, suburbs);
+      graph->candidateBloomFilter(next.clique, frame.suburbs);
       break;
     case CLIQUE_FILTER:
-      graph->candidateCliqueFilter(newClique, suburbs);
+      graph->candidateCliqueFilter(next.clique, frame.suburbs);
       break;
     case NEIGHBOURHOOD_FILTER:
-      graph->candidateNeighbourhoodFilter(suburbs, *v);
+      graph->candidateNeighbourhoodFilter(frame.suburbs, v);
       break;
     case INCREMENTAL_FILTER:
-      graph->candidateIncrementalFilter(clique, suburbs, *v);
+      graph->candidateIncrementalFilter(frame.clique, frame.suburbs, v);
       break;
     default:
       break;
     }
 
-    if (Globals::filteringValue == INCREMENTAL_FILTER || (Globals::filteringValue == BLOOM_FILTER && graph->vertices.size() < 128))
-    {
-      ordCliqueNeighbourhood = suburbs;
-      for (vertex_t v : ordCliqueNeighbourhood)
-        cliqueNeighbourhood.insert(v);
-    }
-    else
-    {
-      cliqueNeighbourhood = graph->cliqueNeighbourhood(newClique, suburbs);
-      for (vertex_t v : cliqueNeighbourhood)
-        ordCliqueNeighbourhood.insert(v);
-    }
+    // The suburbs become the clique neighbourhood
+    if (!(Globals::filteringValue == INCREMENTAL_FILTER || (Globals::filteringValue == BLOOM_FILTER && graph->vertices.size() < 128)))
+      graph->cliqueNeighbourhood(next.clique, frame.suburbs);
 
     /* If there is no way, with the current cliqueNeighbourhood, to find a biggest clique
        and we search one: then let us go to the next singleton. */
-    if ((Globals::maxClique && (biggestClique.size() < newClique.size() + cliqueNeighbourhood.size())) || (!Globals::maxClique && (graph->gillesCoeurCoeur->laurent <= newClique.size() + cliqueNeighbourhood.size())))
+    if ((Globals::maxClique && (biggestClique.size() < next.clique.size() + frame.suburbs.size())) || (!Globals::maxClique && (graph->gillesCoeurCoeur->laurent <= next.clique.size() + frame.suburbs.size())))
     {
-      set<vertex_t, MyComparator> new_candidates = Utils::set_intersection(candidates,
-                                                                           ordCliqueNeighbourhood, graph->comp);
-      set<vertex_t> new_excluded = Utils::set_intersection(excluded, cliqueNeighbourhood);
-      findHypercliques(newClique, new_candidates, new_excluded, graph);
+      Utils::set_intersection(frame.candidates, frame.suburbs, next.candidates);
+      Utils::set_intersection(frame.excluded, frame.suburbs, next.excluded);
+      findHypercliques(frames, depth + 1, graph);
     }
 
-    candidates = Utils::set_difference(candidates, singleton, graph->comp);
-    excluded = Utils::set_union(excluded, singleton);
-    v++;
+    exclude(frame, v);
   }
 }
 
-void BronKerbosch::findCliques(set<vertex_t> clique, set<vertex_t, MyComparator> candidates,
-                               set<vertex_t> excluded, SweetHBK::Graph *graph)
+void BronKerbosch::findCliques(const clique_t &clique, const set<vertex_t> &candidates,
+                               const set<vertex_t> &excluded, SweetHBK::Graph *graph)
+{
+  Frames frames(1);
+  frames[0].assign(clique, candidates, excluded);
+  findCliques(frames, 0, graph);
+}
+
+void BronKerbosch::findCliques(Frames &frames, size_t depth, SweetHBK::Graph *graph)
 {
 
   nbCallToBK++;
 
+  Frame &frame = frames[depth];
   if (Globals::verbose)
-    Utils::printCurrentState(clique, candidates, excluded);
-  if (clique.size() + candidates.size() < graph->gillesCoeurCoeur->laurent)
+    Utils::printCurrentState(frame.clique, SortedRange<vertex_t>(frame.candidates), SortedRange<vertex_t>(frame.excluded));
+  if (frame.clique.size() + frame.candidates.size() < graph->gillesCoeurCoeur->laurent)
     return;
 
-  if (candidates.empty() && excluded.empty())
+  if (frame.candidates.empty() && frame.excluded.empty())
   {
     if (Globals::verbose)
     {
       cout << "c | ... clique found !" << setw(LENGTH - 19) << "|" << endl;
       cout << DLINE << endl;
     }
-    cliques.insert(clique);
+    cliques.insert(frame.clique);
   }
 
-  set<vertex_t, MyComparator>::iterator v = candidates.begin();
-  while (!candidates.empty() && v != candidates.end() && !Globals::timedout)
+  branches(frame, graph, false);
+  frame.excluded.reserve(frame.excluded.size() + frame.candidates.size());
+  Frame &next = nextFrame(frames, depth);
+  mark(frame, graph->gillesCoeurCoeur);
+
+  for (const vertex_t v : frame.branches)
   {
-    set<vertex_t> singleton;
-    singleton.insert(*v);
-
-    findCliques(Utils::set_union(clique, singleton),
-                Utils::set_intersection(candidates, graph->gillesCoeurCoeur->g->neighbors(*v), graph->comp),
-                Utils::set_intersection(excluded, graph->gillesCoeurCoeur->g->neighbors(*v)),
-                graph);
-
-    candidates = Utils::set_difference(candidates, singleton, graph->comp);
-    excluded = Utils::set_union(excluded, singleton);
-    if (!candidates.empty())
-      v = candidates.begin();
+    if (Globals::timedout)
+      break;
+    next.clique = frame.clique;
+    next.clique.insert(v);
+    narrow(frame, next, v, graph->gillesCoeurCoeur);
+
+    findCliques(frames, depth + 1, graph);
+
+    exclude(frame, v);
   }
+  unmark(frame);
+}
+
+void BronKerbosch::findCliquesBis(const clique_t &clique, const set<vertex_t> &candidates,
+                                  const set<vertex_t> &excluded, SweetHBK::Graph *graph)
+{
+  Frames frames(1);
+  frames[0].assign(clique, candidates, excluded);
+  findCliquesBis(frames, 0, graph);
 }
 
-void BronKerbosch::findCliquesBis(set<vertex_t> clique, set<vertex_t, MyComparator> candidates,
-                                  set<vertex_t> excluded, SweetHBK::Graph *graph)
+void BronKerbosch::findCliquesBis(Frames &frames, size_t depth, SweetHBK::Graph *graph)
 {
 
   nbCallToBK++;
 
+  Frame &frame = frames[depth];
   if (Globals::verbose)
-    Utils::printCurrentState(clique, candidates, excluded);
-  if (clique.size() + candidates.size() < graph->gillesCoeurCoeur->laurent)
+    Utils::printCurrentState(frame.clique, SortedRange<vertex_t>(frame.candidates), SortedRange<vertex_t>(frame.excluded));
+  if (frame.clique.size() + frame.candidates.size() < graph->gillesCoeurCoeur->laurent)
     return;
 
-  set<vertex_t, MyComparator> ordExcluded(graph->comp);
-  for (vertex_t v : excluded)
-    ordExcluded.insert(v);
-
-  if (candidates.empty() && (excluded.empty() || (graph->cliqueNeighbourhood(clique, ordExcluded)).empty()))
+  if (frame.candidates.empty() && (frame.excluded.empty() || !graph->hasCliqueNeighbour(frame.clique, SortedRange<vertex_t>(frame.excluded))))
   {
-    cliqueFound(clique);
+    cliqueFound(frame.clique);
   }
   else if (!Globals::timedout)
   {
-    set<vertex_t, MyComparator> new_candidates = candidates;
-    set<vertex_t, MyComparator>::iterator v = new_candidates.begin();
+    branches(frame, graph, true);
+    frame.excluded.reserve(frame.excluded.size() + frame.candidates.size());
+    Frame &next = nextFrame(frames, depth);
+    mark(frame, graph->gillesCoeurCoeur);
 
-    while (!new_candidates.empty() && v != new_candidates.end() && !Globals::timedout)
+    for (const vertex_t v : frame.branches)
     {
-      set<vertex_t> singleton;
-      singleton.insert(*v);
-
-      set<vertex_t> newClique = Utils::set_union(clique, singleton);
+      if (Globals::timedout)
+        break;
+      next.clique = frame.clique;
+      next.clique.insert(v);
 
-      if (graph->gillesCoeurCoeur->isHyperClique(newClique))
+      if (graph->gillesCoeurCoeur->isHyperClique(next.clique))
       {
         /* If it is the biggest clique found for now, then we mark it as such. */
-        if (Globals::maxClique && (biggestClique.size() < newClique.size()))
+        if (Globals::maxClique && (biggestClique.size() < next.clique.size()))
         {
-          biggestClique = newClique;
+          biggestClique = next.clique;
         }
 
-        ConstCollection<vertex_t> voisins = graph->gillesCoeurCoeur->g->neighbors(*v);
-        if ((Globals::maxClique && (biggestClique.size() < newClique.size() + voisins.size())) || (!Globals::maxClique && graph->gillesCoeurCoeur->laurent <= newClique.size() + voisins.size()))
-          findCliquesBis(newClique,
-                         Utils::set_intersection(candidates, voisins, graph->comp),
-                         Utils::set_intersection(excluded, voisins),
-                         graph);
+        SortedRange<vertex_t> voisins = graph->gillesCoeurCoeur->neighbors(v);
+        if ((Globals::maxClique && (biggestClique.size() < next.clique.size() + voisins.size())) || (!Globals::maxClique && graph->gillesCoeurCoeur->laurent <= next.clique.size() + voisins.size()))
+        {
+          narrow(frame, next, v, graph->gillesCoeurCoeur);
+          findCliquesBis(frames, depth + 1, graph);
+        }
       }
 
-      candidates = Utils::set_difference(candidates, singleton, graph->comp);
-      excluded = Utils::set_union(excluded, singleton);
-      v++;
+      exclude(frame, v);
 
-      ordExcluded.clear();
-      for (vertex_t v : excluded)
-        ordExcluded.insert(v);
-      if (candidates.empty() && clique.size() >= graph->gillesCoeurCoeur->laurent && (excluded.empty() || (graph->cliqueNeighbourhood(clique, ordExcluded)).empty()))
+      if (frame.candidates.empty() && frame.clique.size() >= graph->gillesCoeurCoeur->laurent && !graph->hasCliqueNeighbour(frame.clique, SortedRange<vertex_t>(frame.excluded)))
       {
-        cliqueFound(clique);
+        cliqueFound(frame.clique);
       }
     }
+    unmark(frame);
   }
 }
 
-void BronKerbosch::findNonUniformCliques(set<vertex_t> clique, set<vertex_t, MyComparator> candidates,
-                                         set<vertex_t> excluded, SweetHBK::Graph *graph)
+void BronKerbosch::findNonUniformCliques(const clique_t &clique, const set<vertex_t> &candidates,
+                                         const set<vertex_t> &excluded, SweetHBK::Graph *graph)
+{
+  Frames frames(1);
+  frames[0].assign(clique, candidates, excluded);
+  findNonUniformCliques(frames, 0, graph);
+}
+
+void BronKerbosch::findNonUniformCliques(Frames &frames, size_t depth, SweetHBK::Graph *graph)
 {
 
   nbCallToBK++;
 
+  Frame &frame = frames[depth];
   if (Globals::verbose)
-    Utils::printCurrentState(clique, candidates, excluded);
+    Utils::printCurrentState(frame.clique, SortedRange<vertex_t>(frame.candidates), SortedRange<vertex_t>(frame.excluded));
 
-  if (candidates.empty() && clique.size() > 1 && (excluded.empty() || (graph->nonUniformNeighbourhood(clique, excluded)).empty()))
+  if (frame.candidates.empty() && frame.clique.size() > 1 && (frame.excluded.empty() || !graph->hasNonUniformNeighbour(frame.clique, SortedRange<vertex_t>(frame.excluded))))
   {
-    cliqueFound(clique);
+    cliqueFound(frame.clique);
   }
   else
   {
-    set<vertex_t, MyComparator> new_candidates = candidates;
-    set<vertex_t, MyComparator>::iterator v = new_candidates.begin();
+    frame.branches.assign(frame.candidates.begin(), frame.candidates.end());
+    frame.excluded.reserve(frame.excluded.size() + frame.candidates.size());
+    Frame &next = nextFrame(frames, depth);
+    mark(frame, graph->gillesCoeurCoeur);
 
-    while (!new_candidates.empty() && v != new_candidates.end() && !Globals::timedout)
+    for (const vertex_t v : frame.branches)
     {
-      set<vertex_t> singleton;
-      singleton.insert(*v);
-
-      set<vertex_t> newClique = Utils::set_union(clique, singleton);
-      if (graph->gillesCoeurCoeur->isNonUniformClique(newClique))
+      if (Globals::timedout)
+        break;
+      next.clique = frame.clique;
+      next.clique.insert(v);
+      if (graph->gillesCoeurCoeur->isNonUniformClique(next.clique))
       {
-        findNonUniformCliques(newClique,
-                              Utils::set_intersection(candidates, graph->gillesCoeurCoeur->g->neighbors(*v), graph->comp),
-                              Utils::set_intersection(excluded, graph->gillesCoeurCoeur->g->neighbors(*v)),
-                              graph);
+        narrow(frame, next, v, graph->gillesCoeurCoeur);
+        findNonUniformCliques(frames, depth + 1, graph);
       }
 
-      candidates = Utils::set_difference(candidates, singleton, graph->comp);
-      excluded = Utils::set_union(excluded, singleton);
-      v++;
+      exclude(frame, v);
 
-      if (candidates.empty() && clique.size() > 1 && (excluded.empty() || (graph->nonUniformNeighbourhood(clique, excluded)).empty()))
+      if (frame.candidates.empty() && frame.clique.size() > 1 && !graph->hasNonUniformNeighbour(frame.clique, SortedRange<vertex_t>(frame.excluded)))
       {
-        cliqueFound(clique);
+        cliqueFound(frame.clique);
       }
     }
+    unmark(frame);
   }
 }
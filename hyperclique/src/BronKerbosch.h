@@ -23,8 +23,10 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #define BRON_KERBOSCH_H
 
 #include "Graph.h"
+#include "CliqueStore.h"
 #include <utility>
 #include <algorithm>
+#include <deque>
 #include <htd/main.hpp>
 #include <htd/Hypergraph.hpp>
 #include "DegenerencyOrderingAlgorithm.h"
@@ -33,36 +35,133 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 class BronKerbosch
 {
 private:
-  static void jsonClique(set<set<vertex_t>>::iterator it)
+  static void jsonClique(SortedRange<vertex_t> clique)
   {
     cout << "[";
-    set<vertex_t>::iterator vt = it->begin();
+    const vertex_t *vt = clique.begin();
     cout << *vt;
     vt++;
-    for (; vt != it->end(); ++vt)
+    for (; vt != clique.end(); ++vt)
     {
       cout << ", " << *vt;
     }
     cout << "]";
   }
 
+  /**
+   * A depth of the search: its clique, candidates and excluded vertices (sorted), and the lists computed from
+   * them. The frames stay from a call to the next, so that the search reuses their buffers instead of allocating.
+   */
+  struct Frame
+  {
+    clique_t clique;
+    vector<vertex_t> candidates;
+    vector<vertex_t> excluded;
+    vector<vertex_t> branches;
+    vector<vertex_t> suburbs;
+    vector<vertex_t> skipped;
+    vector<vertex_t> redundant;
+    vector<pair<size_t, vertex_t>> bounds;
+    /* The candidates and the excluded vertices as rows of bits while the frame branches, if `marked`
+       (see `HBKGraph::bitRowWords`); all the bits are cleared otherwise. */
+    vector<uint64_t> candidateBits;
+    vector<uint64_t> excludedBits;
+    bool marked = false;
+
+    void assign(const clique_t &clique, const set<vertex_t> &candidates, const set<vertex_t> &excluded)
+    {
+      this->clique = clique;
+      this->candidates.assign(candidates.begin(), candidates.end());
+      this->excluded.assign(excluded.begin(), excluded.end());
+    }
+  };
+
+  /* The frames from the root of the search, in a deque so that a frame does not move when the search goes deeper. */
+  typedef deque<Frame> Frames;
+
+  /**
+   * Returns the frame after `depth`, added if the search never went that deep.
+   */
+  static Frame &nextFrame(Frames &frames, size_t depth)
+  {
+    if (frames.size() == depth + 1)
+      frames.emplace_back();
+    return frames[depth + 1];
+  }
+
+  /**
+   * Moves `vertex` from the candidates of `frame` to its excluded vertices.
+   */
+  static void exclude(Frame &frame, vertex_t vertex)
+  {
+    frame.candidates.erase(lower_bound(frame.candidates.begin(), frame.candidates.end(), vertex));
+    frame.excluded.insert(lower_bound(frame.excluded.begin(), frame.excluded.end(), vertex), vertex);
+    if (frame.marked)
+    {
+      frame.candidateBits[vertex / 64] &= ~((uint64_t)1 << (vertex % 64));
+      frame.excludedBits[vertex / 64] |= (uint64_t)1 << (vertex % 64);
+    }
+  }
+
+  /**
+   * Sets the bits of the candidates and of the excluded vertices of `frame`, if `rank` keeps its neighbourhoods
+   * as rows of bits.
+   */
+  static void mark(Frame &frame, HBKGraph *rank);
+
+  /**
+   * Clears the bits set by `mark`.
+   */
+  static void unmark(Frame &frame);
+
+  /**
+   * Sets the candidates and the excluded vertices of `next` to those of `frame` that are neighbours of `vertex`.
+   */
+  static void narrow(const Frame &frame, Frame &next, vertex_t vertex, HBKGraph *rank)
+  {
+    if (frame.marked)
+    {
+      rank->neighborsIn(SortedRange<vertex_t>(frame.candidates), frame.candidateBits, vertex, next.candidates);
+      rank->neighborsIn(SortedRange<vertex_t>(frame.excluded), frame.excludedBits, vertex, next.excluded);
+    }
+    else
+    {
+      rank->neighborsIn(SortedRange<vertex_t>(frame.candidates), vertex, next.candidates);
+      rank->neighborsIn(SortedRange<vertex_t>(frame.excluded), vertex, next.excluded);
+    }
+  }
+
+  /**
+   * Sets the branches of `frame` to the candidates to branch on: all of them without pivot (see
+   * `Globals::pivotValue`), otherwise those the pivot does not make redundant. In a graph (`hyper` false), the
+   * neighbours of the pivot are redundant; for the hypercliques, the candidates it completes into hyperedges
+   * (see `HBKGraph::completedBy`).
+   */
+  static void branches(Frame &frame, SweetHBK::Graph *graph, bool hyper);
+
+  /* The searches from the frame at `depth`, their children being searched from the next frames. */
+  static void findHypercliques(Frames &frames, size_t depth, SweetHBK::Graph *graph);
+  static void findCliques(Frames &frames, size_t depth, SweetHBK::Graph *graph);
+  static void findCliquesBis(Frames &frames, size_t depth, SweetHBK::Graph *graph);
+  static void findNonUniformCliques(Frames &frames, size_t depth, SweetHBK::Graph *graph);
+
 public:
-  static set<set<vertex_t>> cliques;
+  static CliqueStore cliques;
   static unsigned int nbCallToBK;
-  static set<vertex_t> biggestClique;
+  static clique_t biggestClique;
 
-  static void findHypercliques(set<vertex_t> clique, set<vertex_t, MyComparator> candidates,
-                               set<vertex_t> excluded, SweetHBK::Graph *graph);
-  static void findCliques(set<vertex_t> clique, set<vertex_t, MyComparator> candidates,
-                          set<vertex_t> excluded, SweetHBK::Graph *graph);
-  static void findCliquesBis(set<vertex_t> clique, set<vertex_t, MyComparator> candidates,
-                             set<vertex_t> excluded, SweetHBK::Graph *graph);
-  static void findNonUniformCliques(set<vertex_t> clique, set<vertex_t, MyComparator> candidates,
-                                    set<vertex_t> excluded, SweetHBK::Graph *graph);
+  static void findHypercliques(const clique_t &clique, const set<vertex_t> &candidates,
+                               const set<vertex_t> &excluded, SweetHBK::Graph *graph);
+  static void findCliques(const clique_t &clique, const set<vertex_t> &candidates,
+                          const set<vertex_t> &excluded, SweetHBK::Graph *graph);
+  static void findCliquesBis(const clique_t &clique, const set<vertex_t> &candidates,
+                             const set<vertex_t> &excluded, SweetHBK::Graph *graph);
+  static void findNonUniformCliques(const clique_t &clique, const set<vertex_t> &candidates,
+                                    const set<vertex_t> &excluded, SweetHBK::Graph *graph);
 
   static void print()
   {
-    for (const set<vertex_t> &clique : cliques)
+    for (const SortedRange<vertex_t> clique : cliques)
     {
       cout << "c | {";
       for (const vertex_t v : clique)
@@ -78,19 +177,17 @@ public:
     cout << "[";
     if (cliques.size() > 0)
     {
-      set<set<vertex_t>>::iterator it = cliques.begin();
-      jsonClique(it);
-      it++;
-      for (; it != cliques.end(); it++)
+      jsonClique(cliques[0]);
+      for (size_t i = 1; i < cliques.size(); i++)
       {
         cout << ", ";
-        jsonClique(it);
+        jsonClique(cliques[i]);
       }
     }
     cout << "]";
   }
 
-  static void cliqueFound(set<vertex_t> clique)
+  static void cliqueFound(const clique_t &clique)
   {
     /* If it is the biggest clique found for now, then we mark it as such. */
     if (Globals::maxClique && (biggestClique.size() < clique.size()))
@@ -103,7 +200,7 @@ public:
       cout << DLINE << endl;
     }
     if (!Globals::maxClique)
-      cliques.insert(clique);
+      cliques.insert(clique.begin(), clique.end());
   }
 
   static void cleanBiggest()
@@ -123,7 +220,7 @@ public:
 
   static void printEdge(SweetHBK::Graph *graph)
   {
-    for (const set<vertex_t> &clique : cliques)
+    for (const SortedRange<vertex_t> clique : cliques)
     {
       cout << "c | {";
       for (const vertex_t v : clique)
@@ -131,7 +228,7 @@ public:
         cout << " " << v;
       }
       cout << " }" << endl;
-      set<id_t> edges = graph->gillesCoeurCoeur->getEdges(clique);
+      pool_set<id_t> edges = graph->gillesCoeurCoeur->getEdges(graph->gillesCoeurCoeur->local(clique_t(clique.begin(), clique.end())));
       for (const id_t e : edges)
       {
         cout << "c | " << graph->edgesMap[e] << endl;
@@ -63,20 +63,19 @@ set<vertex_t> CardinalityConstraint::inverse(set<vertex_t> variables)
   return res;
 }
 
-set<CardinalityConstraint *> CardinalityConstraint::toCardinalityConstraint(Clique *clique,
-                                                                            map<id_t, id_t> edgesMap)
+set<CardinalityConstraint *> CardinalityConstraint::toCardinalityConstraint(Clique *clique)
 {
   unsigned long nb_neg = 0, nb_pos = 0;
   set<CardinalityConstraint *> constraints;
   set<vertex_t> variables;
   int reduceBound = 0;
 
-  set<vertex_t>::iterator it = clique->vertices.begin();
+  clique_t::const_iterator it = clique->vertices.begin();
   for (; it != clique->vertices.end(); it++)
   {
     vertex_t i = *it;
 
-    set<vertex_t>::iterator jt = it;
+    clique_t::const_iterator jt = it;
     jt++;
     vertex_t j = jt != clique->vertices.end() ? *jt : 0;
     if (i >> 1 != j >> 1)
@@ -99,17 +98,17 @@ set<CardinalityConstraint *> CardinalityConstraint::toCardinalityConstraint(Cliq
     if (nb_neg == nb)
     { // only negative literals => atMost(laurent - 1) constraint => atLeast(1 - laurent)
       constraints.insert(new CardinalityConstraint(variables, 1 - clique->laurent + reduceBound,
-                                                   cardType::atleast, clique->getClauses(edgesMap), true));
+                                                   cardType::atleast, clique->getClauses(), true));
     }
     else if (nb_pos == nb)
     { // only positive literals => atLeast(nb - laurent + 1) constraint
       constraints.insert(new CardinalityConstraint(variables, nb - clique->laurent + 1 + reduceBound,
-                                                   cardType::atleast, clique->getClauses(edgesMap), true));
+                                                   cardType::atleast, clique->getClauses(), true));
     }
     else
     { // mixed clique => atLeast(nb - laurent + 1) constraint
       constraints.insert(new CardinalityConstraint(variables, nb - clique->laurent + 1 - nb_neg + reduceBound,
-                                                   cardType::atleast, clique->getClauses(edgesMap), true));
+                                                   cardType::atleast, clique->getClauses(), true));
     }
   }
   return constraints;
@@ -100,8 +100,7 @@ public:
 
   static set<vertex_t> reduce(set<vertex_t> variables);
   static set<vertex_t> inverse(set<vertex_t> variables);
-  static set<CardinalityConstraint *> toCardinalityConstraint(Clique *clique,
-                                                              map<id_t, id_t> edgesMap);
+  static set<CardinalityConstraint *> toCardinalityConstraint(Clique *clique);
   static set<CardinalityConstraint *> toCardinalityConstraint(vertex_t literal,
                                                               set<id_t> inferedBy);
   static bool add(set<CardinalityConstraint *> &cardinalities, CardinalityConstraint *newcard);
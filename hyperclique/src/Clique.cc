@@ -21,7 +21,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include "Clique.h"
 
-void Clique::print(map<id_t, id_t> edgesMap)
+void Clique::print()
 {
   cout << "c | {";
   for (const vertex_t v : vertices)
@@ -32,17 +32,12 @@ void Clique::print(map<id_t, id_t> edgesMap)
   cout << "c | [";
   for (const id_t e : edges)
   {
-    cout << " " << edgesMap[e];
+    cout << " " << e;
   }
   cout << " ]" << endl;
 }
 
-set<id_t> Clique::getClauses(map<id_t, id_t> edgesMap)
+set<id_t> Clique::getClauses()
 {
-  set<id_t> res;
-  for (const id_t e : edges)
-  {
-    res.insert(edgesMap[e]);
-  }
-  return res;
+  return edges;
 }
\ No newline at end of file
@@ -28,13 +28,14 @@ class Clique
 {
 public:
   int laurent;
-  set<vertex_t> vertices;
+  clique_t vertices;
+  /** The ids of the hyperedges of the clique in the input. */
   set<id_t> edges;
 
-  Clique(int l, set<vertex_t> v, set<id_t> e) : laurent(l), vertices(v), edges(e) {}
+  Clique(int l, const clique_t &v, set<id_t> e) : laurent(l), vertices(v), edges(e) {}
 
-  void print(map<id_t, id_t> edgesMap);
-  set<id_t> getClauses(map<id_t, id_t> edgesMap);
+  void print();
+  set<id_t> getClauses();
 };
 
 #endif // CLIQUE_H
\ No newline at end of file
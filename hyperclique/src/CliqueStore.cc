@@ -0,0 +1,118 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "CliqueStore.h"
+
+bool CliqueStore::add(size_t start)
+{
+  if (2 * (size() + 1) > slots.size())
+    rehash(slots.empty() ? 64 : 2 * slots.size());
+
+  uint64_t h = Utils::hash(vertices.data() + start, vertices.data() + vertices.size());
+  size_t mask = slots.size() - 1;
+  for (size_t i = h & mask;; i = (i + 1) & mask)
+  {
+    if (!slots[i])
+    {
+      slots[i] = size() + 1;
+      hashes.push_back(h);
+      offsets.push_back(vertices.size());
+      return true;
+    }
+    size_t position = slots[i] - 1;
+    if (hashes[position] == h && offsets[position + 1] - offsets[position] == vertices.size() - start &&
+        equal(vertices.begin() + offsets[position], vertices.begin() + offsets[position + 1], vertices.begin() + start))
+    {
+      vertices.resize(start);
+      return false;
+    }
+  }
+}
+
+void CliqueStore::rehash(size_t nbSlots)
+{
+  slots.assign(nbSlots, 0);
+  size_t mask = nbSlots - 1;
+  for (size_t position = 0; position < size(); position++)
+  {
+    size_t i = hashes[position] & mask;
+    while (slots[i])
+      i = (i + 1) & mask;
+    slots[i] = position + 1;
+  }
+}
+
+bool CliqueStore::includes(SortedRange<vertex_t> clique) const
+{
+  for (const SortedRange<vertex_t> c : *this)
+  {
+    if (std::includes(c.begin(), c.end(), clique.begin(), clique.end()))
+      return true;
+  }
+  return false;
+}
+
+vector<size_t> CliqueStore::order() const
+{
+  vector<size_t> result(size());
+  for (size_t i = 0; i < result.size(); i++)
+    result[i] = i;
+  sort(result.begin(), result.end(), [this](size_t a, size_t b)
+       { return lexicographical_compare(vertices.begin() + offsets[a], vertices.begin() + offsets[a + 1],
+                                        vertices.begin() + offsets[b], vertices.begin() + offsets[b + 1]); });
+  return result;
+}
+
+void CliqueStore::reorder(const vector<size_t> &order)
+{
+  vector<vertex_t> reordered;
+  reordered.reserve(vertices.size());
+  vector<size_t> reorderedOffsets(1, 0);
+  reorderedOffsets.reserve(offsets.size());
+  vector<uint64_t> reorderedHashes;
+  reorderedHashes.reserve(hashes.size());
+  for (const size_t position : order)
+  {
+    reordered.insert(reordered.end(), vertices.begin() + offsets[position], vertices.begin() + offsets[position + 1]);
+    reorderedOffsets.push_back(reordered.size());
+    reorderedHashes.push_back(hashes[position]);
+  }
+  vertices.swap(reordered);
+  offsets.swap(reorderedOffsets);
+  hashes.swap(reorderedHashes);
+  rehash(slots.size());
+}
+
+void CliqueStore::clear()
+{
+  vertices.clear();
+  offsets.assign(1, 0);
+  hashes.clear();
+  slots.clear();
+}
+
+void CliqueStore::swap(CliqueStore &other)
+{
+  vertices.swap(other.vertices);
+  offsets.swap(other.offsets);
+  hashes.swap(other.hashes);
+  slots.swap(other.slots);
+}
@@ -0,0 +1,123 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef CLIQUE_STORE_H
+#define CLIQUE_STORE_H
+
+#include "Utils.h"
+
+/**
+ * A set of cliques, each one a sorted array of vertices.
+ *
+ * The vertices of all the cliques are stored one after the other in a single arena, the i-th clique
+ * being vertices[offsets[i]..offsets[i + 1]). A clique is only added once: an open addressing table of
+ * clique numbers, keyed by the hash of their vertices, finds the copies. The cliques are kept in the
+ * order they were added until `reorder`ed, e.g. by `order` in the order of a `set<set<vertex_t>>`.
+ */
+class CliqueStore
+{
+public:
+  class const_iterator
+  {
+  public:
+    const_iterator(const CliqueStore *store, size_t position) : store(store), position(position) {}
+
+    SortedRange<vertex_t> operator*() const { return (*store)[position]; }
+    const_iterator &operator++()
+    {
+      position++;
+      return *this;
+    }
+    bool operator!=(const const_iterator &other) const { return position != other.position; }
+    bool operator==(const const_iterator &other) const { return position == other.position; }
+
+  private:
+    const CliqueStore *store;
+    size_t position;
+  };
+
+  CliqueStore() : offsets(1, 0) {}
+
+  size_t size() const { return offsets.size() - 1; }
+  bool empty() const { return offsets.size() == 1; }
+
+  /**
+   * Returns the sorted vertices of the `position`-th clique.
+   */
+  SortedRange<vertex_t> operator[](size_t position) const
+  {
+    return SortedRange<vertex_t>(vertices.data() + offsets[position], vertices.data() + offsets[position + 1]);
+  }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size()); }
+
+  /**
+   * Adds the clique of the sorted vertices [first, last), unless it is already there.
+   * Returns `true` if it was added.
+   */
+  template <typename I>
+  bool insert(I first, I last)
+  {
+    size_t start = vertices.size();
+    vertices.insert(vertices.end(), first, last);
+    return add(start);
+  }
+
+  bool insert(const set<vertex_t> &clique) { return insert(clique.begin(), clique.end()); }
+  bool insert(const vector<vertex_t> &clique) { return insert(clique.begin(), clique.end()); }
+  bool insert(SortedRange<vertex_t> clique) { return insert(clique.begin(), clique.end()); }
+  bool insert(const clique_t &clique) { return insert(clique.begin(), clique.end()); }
+
+  /**
+   * Returns `true` if a clique includes all the given sorted vertices.
+   */
+  bool includes(SortedRange<vertex_t> clique) const;
+
+  /**
+   * Returns the positions of the cliques in lexicographic order.
+   */
+  vector<size_t> order() const;
+
+  /**
+   * Puts the `order[i]`-th clique in the i-th position, `order` being a permutation of the positions.
+   */
+  void reorder(const vector<size_t> &order);
+
+  void clear();
+  void swap(CliqueStore &other);
+
+private:
+  vector<vertex_t> vertices;
+  vector<size_t> offsets;
+  vector<uint64_t> hashes;
+
+  /* The open addressing table: the position + 1 of a clique, or 0 for a free slot. */
+  vector<size_t> slots;
+
+  /**
+   * Adds the clique of the vertices of the arena from `start` on, or drops them if it is already there.
+   */
+  bool add(size_t start);
+  void rehash(size_t nbSlots);
+};
+
+#endif // CLIQUE_STORE_H
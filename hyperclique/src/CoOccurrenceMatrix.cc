@@ -0,0 +1,124 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "CoOccurrenceMatrix.h"
+#include <algorithm>
+#include <functional>
+
+CoOccurrenceMatrix::CoOccurrenceMatrix(const Hypergraph &graph)
+{
+  size_t n = graph.vertexCount();
+  ConstCollection<Hyperedge> hyperedges = graph.hyperedges();
+
+  /* The vertices of the hyperedges, and the hyperedges of each vertex, by counting sort. */
+  vector<size_t> edgeOffsets(1, 0);
+  vector<vertex_t> edgeVertices;
+  degrees.assign(n + 1, 0);
+  for (const Hyperedge &e : hyperedges)
+  {
+    for (const vertex_t v : e.sortedElements())
+    {
+      edgeVertices.push_back(v);
+      degrees[v]++;
+    }
+    edgeOffsets.push_back(edgeVertices.size());
+  }
+  vector<size_t> vertexOffsets(n + 2, 0);
+  for (size_t v = 1; v <= n; v++)
+    vertexOffsets[v + 1] = vertexOffsets[v] + degrees[v];
+  vector<uint32_t> vertexEdges(vertexOffsets[n + 1]);
+  vector<size_t> next(vertexOffsets.begin(), vertexOffsets.end() - 1);
+  for (size_t e = 0; e + 1 < edgeOffsets.size(); e++)
+    for (size_t i = edgeOffsets[e]; i < edgeOffsets[e + 1]; i++)
+      vertexEdges[next[edgeVertices[i]]++] = e;
+
+  /* Each row is accumulated in `accumulator`, indexed by the neighbours met in `touched`. */
+  vector<unsigned int> accumulator(n + 1, 0);
+  vector<vertex_t> touched;
+  neighbours.assign(n + 1, 0);
+  offsets.assign(n + 2, 0);
+  for (vertex_t v = 1; v <= n; v++)
+  {
+    touched.clear();
+    for (size_t i = vertexOffsets[v]; i < vertexOffsets[v + 1]; i++)
+    {
+      uint32_t e = vertexEdges[i];
+      for (size_t j = edgeOffsets[e]; j < edgeOffsets[e + 1]; j++)
+      {
+        vertex_t u = edgeVertices[j];
+        if (u == v)
+          continue;
+        if (!accumulator[u]++)
+          touched.push_back(u);
+      }
+    }
+    sort(touched.begin(), touched.end());
+    for (const vertex_t u : touched)
+    {
+      columns.push_back(u);
+      counts.push_back(accumulator[u]);
+      accumulator[u] = 0;
+    }
+    neighbours[v] = touched.size();
+    offsets[v + 1] = columns.size();
+  }
+}
+
+size_t CoOccurrenceMatrix::position(vertex_t u, vertex_t v) const
+{
+  vector<vertex_t>::const_iterator first = columns.begin() + offsets[u], last = columns.begin() + offsets[u + 1];
+  vector<vertex_t>::const_iterator it = lower_bound(first, last, v);
+  return (it != last && *it == v) ? it - columns.begin() : columns.size();
+}
+
+unsigned int CoOccurrenceMatrix::count(vertex_t u, vertex_t v) const
+{
+  size_t i = position(u, v);
+  return i == columns.size() ? 0 : counts[i];
+}
+
+unsigned int CoOccurrenceMatrix::greatest(vertex_t vertex, unsigned int rank) const
+{
+  vector<unsigned int> row;
+  row.reserve(neighbours[vertex]);
+  for (size_t i = offsets[vertex]; i < offsets[vertex + 1]; i++)
+  {
+    if (counts[i])
+      row.push_back(counts[i]);
+  }
+  nth_element(row.begin(), row.begin() + (rank - 1), row.end(), greater<unsigned int>());
+  return row[rank - 1];
+}
+
+void CoOccurrenceMatrix::removeEdge(const vector<vertex_t> &vertices)
+{
+  for (const vertex_t u : vertices)
+  {
+    degrees[u]--;
+    for (const vertex_t v : vertices)
+    {
+      if (u == v)
+        continue;
+      if (!--counts[position(u, v)])
+        neighbours[u]--;
+    }
+  }
+}
@@ -0,0 +1,86 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef CO_OCCURRENCE_MATRIX_H
+#define CO_OCCURRENCE_MATRIX_H
+
+#include <vector>
+#include <htd/main.hpp>
+using namespace std;
+using namespace htd;
+
+/**
+ * The number of hyperedges shared by each pair of vertices of a hypergraph, i.e. the product of its
+ * incidence matrix by its transpose, restricted to the pairs of neighbours.
+ *
+ * The row of a vertex holds its sorted neighbours and, in the same positions, their counts. The rows
+ * are accumulated one vertex at a time in a dense array, from the hyperedges of the vertex, and then
+ * stored contiguously. The diagonal (the degree of each vertex) is kept apart. The counts follow the
+ * hyperedges removed with `removeEdge`, so that the node filters can read them while they prune.
+ */
+class CoOccurrenceMatrix
+{
+public:
+  /**
+   * Counts the co-occurrences of the vertices (from 1) of `graph`.
+   */
+  CoOccurrenceMatrix(const Hypergraph &graph);
+
+  /**
+   * Returns the number of hyperedges containing `vertex`.
+   */
+  unsigned int degree(vertex_t vertex) const { return degrees[vertex]; }
+
+  /**
+   * Returns the number of vertices sharing at least a hyperedge with `vertex`.
+   */
+  unsigned int nbNeighbours(vertex_t vertex) const { return neighbours[vertex]; }
+
+  /**
+   * Returns the number of hyperedges containing both `u` and `v` (`u` != `v`).
+   */
+  unsigned int count(vertex_t u, vertex_t v) const;
+
+  /**
+   * Returns the `rank`-th (from 1) greatest number of hyperedges shared by `vertex` and one of its
+   * neighbours. `rank` must be at most `nbNeighbours(vertex)`.
+   */
+  unsigned int greatest(vertex_t vertex, unsigned int rank) const;
+
+  /**
+   * Removes from the counts a hyperedge made of the given (distinct) vertices.
+   */
+  void removeEdge(const vector<vertex_t> &vertices);
+
+private:
+  vector<unsigned int> degrees;
+  vector<unsigned int> neighbours;
+
+  /* The neighbours of vertex v are columns[offsets[v]..offsets[v + 1]), sorted, and counts[i] is
+     the number of hyperedges shared by v and columns[i]. */
+  vector<size_t> offsets;
+  vector<vertex_t> columns;
+  vector<unsigned int> counts;
+
+  size_t position(vertex_t u, vertex_t v) const;
+};
+
+#endif // CO_OCCURRENCE_MATRIX_H
@@ -49,4 +49,18 @@ using namespace std;
 #define BOTH_FILTER 3
 #define NB_NODE_FILTER 4
 
+#define NO_PIVOT 0
+#define TOMITA_PIVOT 1
+#define DEGREE_PIVOT 2
+
+#define MIN_PARSING_CHUNK (1 << 20)
+#define PARSING_BLOCK (1 << 20)
+#define DECOMPRESSION_BLOCK (1 << 18)
+#define PREDICTION_SAMPLE (1 << 16)
+#define SQLITE_BATCH 1000
+#define ADJACENCY_BUDGET (64 << 20)
+#define CLIQUE_CAPACITY 16
+#define NODE_POOL_BLOCK 128
+#define NODE_POOL_CHUNK (64 << 10)
+
 #endif // CONSTANTS_H
\ No newline at end of file
@@ -0,0 +1,225 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "Decompressor.h"
+#include "Constants.h"
+#include <cstring>
+#include <climits>
+#include <algorithm>
+#include <zlib.h>
+#include <bzlib.h>
+#include <zstd.h>
+
+/* The sizes given to zlib and bzip2 are unsigned int: a large input is fed in several pieces. */
+#define INPUT_PIECE (1U << 30)
+
+compressionType Decompressor::compression(const char *begin, const char *end)
+{
+  size_t size = end - begin;
+  const unsigned char *p = (const unsigned char *)begin;
+  if (size >= 2 && p[0] == 0x1f && p[1] == 0x8b)
+    return gzip;
+  if (size >= 3 && p[0] == 'B' && p[1] == 'Z' && p[2] == 'h')
+    return bzip2;
+  if (size >= 4 && p[0] == 0x28 && p[1] == 0xb5 && p[2] == 0x2f && p[3] == 0xfd)
+    return zstd;
+  return uncompressed;
+}
+
+Decompressor::Decompressor(const char *begin, const char *end, compressionType type)
+    : valid(false), corrupted(false), next(begin), end(end), type(type), stream(NULL), complete(false),
+      flushing(false), block(DECOMPRESSION_BLOCK)
+{
+  switch (type)
+  {
+  case gzip:
+  {
+    z_stream *z = new z_stream();
+    /* 15 + 32: maximal window and automatic detection of the gzip header */
+    if (inflateInit2(z, 15 + 32) != Z_OK)
+    {
+      delete z;
+      return;
+    }
+    stream = z;
+    break;
+  }
+  case bzip2:
+  {
+    bz_stream *bz = new bz_stream();
+    if (BZ2_bzDecompressInit(bz, 0, 0) != BZ_OK)
+    {
+      delete bz;
+      return;
+    }
+    stream = bz;
+    break;
+  }
+  case zstd:
+  {
+    ZSTD_DStream *zs = ZSTD_createDStream();
+    if (zs == NULL || ZSTD_isError(ZSTD_initDStream(zs)))
+    {
+      ZSTD_freeDStream(zs);
+      return;
+    }
+    stream = zs;
+    break;
+  }
+  default:
+    setg((char *)begin, (char *)begin, (char *)end);
+    complete = true;
+    break;
+  }
+  valid = true;
+}
+
+Decompressor::~Decompressor()
+{
+  if (stream == NULL)
+    return;
+  switch (type)
+  {
+  case gzip:
+    inflateEnd((z_stream *)stream);
+    delete (z_stream *)stream;
+    break;
+  case bzip2:
+    BZ2_bzDecompressEnd((bz_stream *)stream);
+    delete (bz_stream *)stream;
+    break;
+  case zstd:
+    ZSTD_freeDStream((ZSTD_DStream *)stream);
+    break;
+  default:
+    break;
+  }
+}
+
+Decompressor::int_type Decompressor::underflow()
+{
+  if (gptr() < egptr())
+    return traits_type::to_int_type(*gptr());
+
+  size_t n = decompress();
+  if (n == 0)
+    return traits_type::eof();
+  setg(block.data(), block.data(), block.data() + n);
+  return traits_type::to_int_type(*gptr());
+}
+
+size_t Decompressor::decompress()
+{
+  size_t produced = 0;
+  if (!valid || corrupted)
+    return 0;
+
+  switch (type)
+  {
+  case gzip:
+  {
+    z_stream *z = (z_stream *)stream;
+    while (produced == 0 && !corrupted)
+    {
+      if (z->avail_in == 0)
+      {
+        if (next == end)
+          break;
+        z->next_in = (Bytef *)next;
+        z->avail_in = min((size_t)(end - next), (size_t)INPUT_PIECE);
+        next += z->avail_in;
+      }
+      z->next_out = (Bytef *)block.data();
+      z->avail_out = block.size();
+      int ret = inflate(z, Z_NO_FLUSH);
+      produced = block.size() - z->avail_out;
+      complete = (ret == Z_STREAM_END);
+      /* Concatenated gzip members are decompressed one after the other */
+      if (ret == Z_STREAM_END && (z->avail_in > 0 || next < end))
+        corrupted = (inflateReset(z) != Z_OK);
+      else if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+        corrupted = true;
+    }
+    break;
+  }
+  case bzip2:
+  {
+    bz_stream *bz = (bz_stream *)stream;
+    while (produced == 0 && !corrupted)
+    {
+      if (bz->avail_in == 0)
+      {
+        if (next == end)
+          break;
+        bz->next_in = (char *)next;
+        bz->avail_in = min((size_t)(end - next), (size_t)INPUT_PIECE);
+        next += bz->avail_in;
+      }
+      bz->next_out = block.data();
+      bz->avail_out = block.size();
+      int ret = BZ2_bzDecompress(bz);
+      produced = block.size() - bz->avail_out;
+      complete = (ret == BZ_STREAM_END);
+      /* Concatenated bzip2 streams (e.g. from pbzip2) are decompressed one after the other */
+      if (ret == BZ_STREAM_END && (bz->avail_in > 0 || next < end))
+      {
+        char *in = bz->next_in;
+        unsigned int avail = bz->avail_in;
+        BZ2_bzDecompressEnd(bz);
+        corrupted = (BZ2_bzDecompressInit(bz, 0, 0) != BZ_OK);
+        bz->next_in = in;
+        bz->avail_in = avail;
+      }
+      else if (ret != BZ_OK && ret != BZ_STREAM_END)
+        corrupted = true;
+    }
+    break;
+  }
+  case zstd:
+  {
+    ZSTD_DStream *zs = (ZSTD_DStream *)stream;
+    while (produced == 0 && !corrupted && (next < end || flushing))
+    {
+      ZSTD_inBuffer in = {next, (size_t)(end - next), 0};
+      ZSTD_outBuffer out = {block.data(), block.size(), 0};
+      size_t ret = ZSTD_decompressStream(zs, &out, &in);
+      next += in.pos;
+      if (ZSTD_isError(ret))
+        corrupted = true;
+      else
+      {
+        produced = out.pos;
+        /* 0 once the frame is entirely decoded and flushed */
+        complete = (ret == 0);
+        flushing = !complete && out.pos == out.size;
+      }
+    }
+    break;
+  }
+  default:
+    break;
+  }
+
+  /* The end of the input is reached in the middle of the compressed data */
+  if (produced == 0 && !complete)
+    corrupted = true;
+  return produced;
+}
@@ -0,0 +1,87 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef DECOMPRESSOR_H
+#define DECOMPRESSOR_H
+
+#include <streambuf>
+#include <vector>
+#include <cstddef>
+using namespace std;
+
+enum compressionType
+{
+  uncompressed,
+  gzip,
+  bzip2,
+  zstd
+};
+
+/**
+ * Input stream buffer decompressing a gzip, bzip2 or zstd buffer (e.g. a memory-mapped file) block by block.
+ * Only one block of the decompressed data is held in memory at a time.
+ * An uncompressed buffer is read as is.
+ */
+class Decompressor : public streambuf
+{
+public:
+  /**
+   * Prepares the decompression of [begin, end), compressed with `type`.
+   * `valid` is `false` if the decompressor cannot be initialized.
+   */
+  Decompressor(const char *begin, const char *end, compressionType type);
+  ~Decompressor();
+
+  bool valid;
+
+  /**
+   * `true` once an error occurred in the compressed data (e.g. a truncated file).
+   */
+  bool corrupted;
+
+  /**
+   * Returns the compression of the given buffer, recognized by its magic number.
+   */
+  static compressionType compression(const char *begin, const char *end);
+
+protected:
+  int_type underflow();
+
+private:
+  const char *next;
+  const char *end;
+  compressionType type;
+  void *stream;
+  bool complete; // the last gzip member, bzip2 stream or zstd frame is complete
+  bool flushing; // the decoder may still hold decompressed data
+  vector<char> block;
+
+  /**
+   * Decompresses the next block of data in `block`.
+   * Returns the number of bytes written, 0 at the end of the data or on error.
+   */
+  size_t decompress();
+
+  Decompressor(const Decompressor &);
+  Decompressor &operator=(const Decompressor &);
+};
+
+#endif // DECOMPRESSOR_H
@@ -41,6 +41,9 @@ public:
   static unsigned int filteringValue;
   static unsigned int orderingValue;
   static unsigned int nodeFilteringValue;
+  static unsigned int pivotValue;
+  static unsigned int parsingThreads;
+  static size_t adjacencyBudget;
   static double timer;
   static bool timedout;
   static string jsonLine;
@@ -21,16 +21,140 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include "Graph.h"
 #include "BronKerbosch.h"
+#include <cstring>
+#include <thread>
 
-SweetHBK::Graph::Graph()
+/**
+ * Skips the blanks (but not the end of line) starting at `p`.
+ */
+static inline const char *skipBlanks(const char *p, const char *end)
+{
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+    p++;
+  return p;
+}
+
+/**
+ * Decodes the integer starting at `p` (after the blanks) and stores it in `value`.
+ * Returns the position following the token, or `NULL` if there is no token left on the line.
+ */
+static inline const char *readInt(const char *p, const char *end, long &value)
+{
+  p = skipBlanks(p, end);
+  if (p == end || *p == '\n')
+    return NULL;
+
+  bool negative = (*p == '-');
+  if (negative)
+    p++;
+
+  value = 0;
+  while (p < end && *p >= '0' && *p <= '9')
+    value = value * 10 + (*p++ - '0');
+  if (negative)
+    value = -value;
+
+  // Ignores what remains of a malformed token
+  while (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n')
+    p++;
+  return p;
+}
+
+/**
+ * Skips the word starting at `p` (after the blanks).
+ */
+static inline const char *skipWord(const char *p, const char *end)
+{
+  p = skipBlanks(p, end);
+  while (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n')
+    p++;
+  return p;
+}
+
+/**
+ * Decodes the hyperedge line [p, eol): its id followed by its vertices.
+ * Returns false if the line is empty.
+ */
+static inline bool readHyperedge(const char *p, const char *eol, id_t &id, vector<vertex_t> &elements)
+{
+  long value = 0;
+  const char *q = readInt(p, eol, value);
+  if (q == NULL)
+    return false;
+
+  id = value;
+  elements.clear();
+  while ((q = readInt(q, eol, value)) != NULL)
+  {
+    if (value > 0)
+      elements.push_back(value);
+  }
+  return true;
+}
+
+/**
+ * Encodes the DIMACS literal `literal` as a vertex: 2v for the literal v and 2v+1 for its negation -v,
+ * the encoding expected by `CardinalityConstraint`.
+ */
+static inline vertex_t literalToVertex(long literal)
+{
+  return literal > 0 ? 2 * literal : 2 * -literal + 1;
+}
+
+/**
+ * The hyperedges decoded by a parsing thread, stored contiguously:
+ * the elements of the i-th hyperedge are elements[offsets[i]..offsets[i + 1]).
+ */
+struct EdgeChunk
+{
+  vector<id_t> ids;
+  vector<size_t> offsets;
+  vector<vertex_t> elements;
+};
+
+/**
+ * Decodes the hyperedges of [begin, end), which starts and ends on a line boundary.
+ * The elements of each hyperedge are sorted here, to leave as little work as possible to the merge.
+ * Only the hyperedge lines are expected after the problem line, so any other line is ignored.
+ */
+static void readChunk(const char *begin, const char *end, EdgeChunk *chunk)
 {
-  gillesCoeurCoeur = new HBKGraph();
-  unsigned int nbVertices, nbEdges;
+  vector<vertex_t> elements;
+  chunk->offsets.push_back(0);
+  const char *p = begin;
+  while (p < end)
+  {
+    const char *eol = (const char *)memchr(p, '\n', end - p);
+    if (eol == NULL)
+      eol = end;
+
+    id_t id;
+    if (*p != 'c' && *p != 'p' && readHyperedge(p, eol, id, elements))
+    {
+      std::sort(elements.begin(), elements.end());
+      chunk->ids.push_back(id);
+      chunk->elements.insert(chunk->elements.end(), elements.begin(), elements.end());
+      chunk->offsets.push_back(chunk->elements.size());
+    }
+    p = eol + 1;
+  }
+}
 
+void SweetHBK::Graph::init()
+{
+  cnf = false;
+  nbClauses = 0;
+  wholeGraph = gillesCoeurCoeur = new HBKGraph();
+  rankGraphsOrdering = rankGraphsNodeFiltering = NB_ORDER + NB_NODE_FILTER;
   bloom = new BloomFilter();
+  stats = NULL;
+  nbHyperedges = 0;
   biggestHyperedge = 0;
+}
 
-  Stath *stats;
+SweetHBK::Graph::Graph()
+{
+  init();
 
   for (string line; getline(cin, line);)
   {
@@ -43,25 +167,15 @@ SweetHBK::Graph::Graph()
 
     if (line[0] == 'p')
     {
-      nbVertices = stoi(tokens[2]);
-      nbEdges = stoi(tokens[3]);
-
-      if (Globals::statsh)
-        stats = new Stath(nbVertices, nbEdges);
-      else if (Globals::json)
-        Globals::jsonLine += ", \"hyperedges\": " + to_string(nbEdges) + ", \"nodes\": " + to_string(nbVertices);
+      cnf = (tokens[1] == "cnf");
+      if (cnf)
+        setSize(2 * stoi(tokens[2]) + 1, stoi(tokens[3]));
       else
-      {
-        cout << "c | *  " << setw(8) << nbEdges << " hyperedges" << setw(LENGTH - 23) << "|" << endl;
-        cout << "c | *  " << setw(8) << nbVertices << " nodes" << setw(LENGTH - 18) << "|" << endl;
-      }
-
-      unsigned int i = 0;
-      while (i < nbVertices)
-      {
-        vertices.insert(gillesCoeurCoeur->g->addVertex());
-        i++;
-      }
+        setSize(stoi(tokens[2]), stoi(tokens[3]));
+    }
+    else if (cnf)
+    {
+      readClauses(line.data(), line.data() + line.size());
     }
     else
     {
@@ -87,24 +201,248 @@ SweetHBK::Graph::Graph()
         }
       }
 
-      if (elements.size() > biggestHyperedge)
-        biggestHyperedge = elements.size();
+      addHyperedge(id, elements);
+    }
+  }
 
-      if (Globals::statsh)
-        stats->addEdge(elements);
+  parsingDone();
+}
 
-      if (elements.size() > 0)
+SweetHBK::Graph::Graph(const char *begin, const char *end)
+{
+  init();
+  readLines(begin, end, Globals::parsingThreads > 1);
+  parsingDone();
+}
+
+SweetHBK::Graph::Graph(streambuf *input)
+{
+  init();
+
+  /* The input is read by blocks and only its complete lines are decoded;
+     the last partial line is moved to the front of the block and completed by the next read. */
+  vector<char> block(PARSING_BLOCK);
+  size_t kept = 0;
+  streamsize n;
+  while ((n = input->sgetn(block.data() + kept, block.size() - kept)) > 0)
+  {
+    const char *last = block.data() + kept + n;
+    const char *eol = last;
+    while (eol > block.data() && eol[-1] != '\n')
+      eol--;
+    if (eol == block.data())
+    {
+      // A line longer than the block
+      kept = last - block.data();
+      if (kept == block.size())
+        block.resize(2 * block.size());
+      continue;
+    }
+    readLines(block.data(), eol, false);
+    kept = last - eol;
+    memmove(block.data(), eol, kept);
+  }
+  readLines(block.data(), block.data() + kept, false);
+
+  parsingDone();
+}
+
+void SweetHBK::Graph::readLines(const char *begin, const char *end, bool chunked)
+{
+  vector<vertex_t> elements;
+  const char *p = begin;
+  while (p < end)
+  {
+    const char *eol = (const char *)memchr(p, '\n', end - p);
+    if (eol == NULL)
+      eol = end;
+
+    if (*p == 'p')
+    {
+      long nbVertices = 0, nbEdges = 0;
+      const char *format = skipBlanks(p + 1, eol);
+      const char *q = skipWord(format, eol);
+      cnf = (q - format == 3 && strncmp(format, "cnf", 3) == 0);
+      if ((q = readInt(q, eol, nbVertices)) != NULL)
+        readInt(q, eol, nbEdges);
+      setSize(cnf ? 2 * nbVertices + 1 : nbVertices, nbEdges);
+
+      if (cnf && eol < end)
+      {
+        readClauses(eol + 1, end);
+        break;
+      }
+      if (chunked && eol < end)
       {
-        std::sort(elements.begin(), elements.end());
-        int laurent = elements.size();
-        edges.insert(pair<id_t, vector<vertex_t>>(id, elements));
-        laurentToEdges[laurent].insert(id);
-        laurentToVertices[laurent].insert(elements.begin(), elements.end());
-        if (Globals::filteringValue == BLOOM_FILTER)
-          bloom->add(elements);
+        readChunks(eol + 1, end);
+        break;
       }
     }
+    else if (cnf)
+    {
+      readClauses(p, end);
+      break;
+    }
+    else if (*p != 'c')
+    {
+      id_t id;
+      if (readHyperedge(p, eol, id, elements))
+        addHyperedge(id, elements);
+    }
+    p = eol + 1;
   }
+}
+
+void SweetHBK::Graph::readClauses(const char *begin, const char *end)
+{
+  const char *p = begin;
+  while (p < end)
+  {
+    const char *eol = (const char *)memchr(p, '\n', end - p);
+    if (eol == NULL)
+      eol = end;
+
+    // SATLIB instances end with a '%' line
+    if (*p != 'c' && *p != '%')
+    {
+      long literal;
+      const char *q = p;
+      while ((q = readInt(q, eol, literal)) != NULL)
+      {
+        if (literal != 0)
+          clause.push_back(literalToVertex(literal));
+        else
+          addClause();
+      }
+    }
+    p = eol + 1;
+  }
+}
+
+void SweetHBK::Graph::addClause()
+{
+  if (clause.empty())
+    return;
+
+  /* The clauses are numbered from 1 in the order of the file: `edgesMap` maps the hyperedges back to them. */
+  std::sort(clause.begin(), clause.end());
+  clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+  addHyperedge(++nbClauses, clause);
+  clause.clear();
+}
+
+void SweetHBK::Graph::readChunks(const char *begin, const char *end)
+{
+  size_t nbChunks = min((size_t)Globals::parsingThreads, (size_t)(end - begin) / MIN_PARSING_CHUNK + 1);
+  size_t chunkSize = (end - begin) / nbChunks;
+
+  vector<EdgeChunk> chunks(nbChunks);
+  vector<thread> threads;
+  const char *from = begin;
+  for (size_t i = 0; i < nbChunks && from < end; i++)
+  {
+    const char *to = end;
+    if (i + 1 < nbChunks && from + chunkSize < end)
+    {
+      to = (const char *)memchr(from + chunkSize, '\n', end - from - chunkSize);
+      to = (to == NULL) ? end : to + 1;
+    }
+    threads.push_back(thread(readChunk, from, to, &chunks[i]));
+    from = to;
+  }
+  for (thread &t : threads)
+    t.join();
+
+  /* The chunks are merged in the order of the file: the hyperedges are the same as with a single thread. */
+  vector<vertex_t> elements;
+  for (EdgeChunk &chunk : chunks)
+  {
+    for (size_t e = 0; e < chunk.ids.size(); e++)
+    {
+      elements.assign(chunk.elements.begin() + chunk.offsets[e], chunk.elements.begin() + chunk.offsets[e + 1]);
+      addHyperedge(chunk.ids[e], elements);
+    }
+    vector<vertex_t>().swap(chunk.elements);
+  }
+}
+
+SweetHBK::Graph::Graph(const Snapshot &snapshot)
+{
+  init();
+  setSize(snapshot.header->nbVertices, snapshot.header->nbEdges);
+  biggestHyperedge = snapshot.header->biggestHyperedge;
+
+  for (uint32_t e = 0; e < snapshot.header->edgeCount; e++)
+  {
+    map<id_t, vector<vertex_t>>::iterator it =
+        edges.emplace_hint(edges.end(), snapshot.edgeIds[e],
+                           vector<vertex_t>(snapshot.edgeVertices + snapshot.edgeOffsets[e],
+                                            snapshot.edgeVertices + snapshot.edgeOffsets[e + 1]));
+    if (Globals::statsh)
+      stats->addEdge(it->second);
+    if (Globals::filteringValue == BLOOM_FILTER)
+      bloom->add(it->second);
+  }
+
+  /* The per-rank arrays are sorted: the insertions at the end are in constant time. */
+  for (uint32_t r = 0; r < snapshot.header->rankCount; r++)
+  {
+    id_t laurent = snapshot.ranks[r];
+    laurentToEdges[laurent].insert(snapshot.rankEdges + snapshot.rankEdgeOffsets[r],
+                                   snapshot.rankEdges + snapshot.rankEdgeOffsets[r + 1]);
+    laurentToVertices[laurent].insert(snapshot.rankVertices + snapshot.rankVertexOffsets[r],
+                                      snapshot.rankVertices + snapshot.rankVertexOffsets[r + 1]);
+  }
+
+  parsingDone();
+}
+
+void SweetHBK::Graph::setSize(unsigned int nbVertices, unsigned int nbEdges)
+{
+  nbHyperedges = nbEdges;
+  if (Globals::statsh)
+    stats = new Stath(nbVertices, nbEdges);
+  else if (Globals::json)
+    Globals::jsonLine += ", \"hyperedges\": " + to_string(nbEdges) + ", \"nodes\": " + to_string(nbVertices);
+  else
+  {
+    cout << "c | *  " << setw(8) << nbEdges << " hyperedges" << setw(LENGTH - 23) << "|" << endl;
+    cout << "c | *  " << setw(8) << nbVertices << " nodes" << setw(LENGTH - 18) << "|" << endl;
+  }
+
+  unsigned int i = 0;
+  while (i < nbVertices)
+  {
+    vertices.insert(vertices.end(), wholeGraph->g->addVertex());
+    i++;
+  }
+}
+
+void SweetHBK::Graph::addHyperedge(id_t id, vector<vertex_t> &elements)
+{
+  if (elements.size() > biggestHyperedge)
+    biggestHyperedge = elements.size();
+
+  if (Globals::statsh)
+    stats->addEdge(elements);
+
+  if (elements.size() > 0)
+  {
+    std::sort(elements.begin(), elements.end());
+    int laurent = elements.size();
+    edges.insert(pair<id_t, vector<vertex_t>>(id, elements));
+    laurentToEdges[laurent].insert(id);
+    laurentToVertices[laurent].insert(elements.begin(), elements.end());
+    if (Globals::filteringValue == BLOOM_FILTER)
+      bloom->add(elements);
+  }
+}
+
+void SweetHBK::Graph::parsingDone()
+{
+  // The last clause of a CNF file may lack its terminating 0
+  if (cnf)
+    addClause();
 
   if (Globals::statsh)
   {
@@ -124,7 +462,7 @@ SweetHBK::Graph::Graph()
     cout << "c | *  " << setw(8) << biggestHyperedge << " max rank" << setw(LENGTH - 21) << "|" << endl;
 }
 
-void SweetHBK::Graph::orderSeq(set<vertex_t> vertices)
+vector<vertex_t> SweetHBK::Graph::orderSeq()
 {
 
   // Create a management instance of the 'htd' library in order to allow centralized configuration.
@@ -171,8 +509,9 @@ void SweetHBK::Graph::orderSeq(set<vertex_t> vertices)
     val[sequence[i] - 1] = i + 1;
   }
 
+  delete order;
   delete ordering;
-  comp.setSequence(val);
+  return val;
 }
 
 map<id_t, vertex_t> SweetHBK::Graph::getUnit()
@@ -188,14 +527,15 @@ map<id_t, vertex_t> SweetHBK::Graph::getUnit()
   return res;
 }
 
-void SweetHBK::Graph::getHyperClique(set<vertex_t, MyComparator> &vertices)
+void SweetHBK::Graph::getHyperClique(set<vertex_t> &vertices)
 {
-  set<vertex_t> R, X;
+  clique_t R;
+  set<vertex_t> X;
   getHyperClique(R, vertices, X);
   return;
 }
 
-void SweetHBK::Graph::getHyperClique(set<vertex_t> &clique, set<vertex_t, MyComparator> &candidates, set<vertex_t> &excluded)
+void SweetHBK::Graph::getHyperClique(clique_t &clique, set<vertex_t> &candidates, set<vertex_t> &excluded)
 {
   if (gillesCoeurCoeur->g->edgeCount() == 0)
     return;
@@ -203,14 +543,15 @@ void SweetHBK::Graph::getHyperClique(set<vertex_t> &clique, set<vertex_t, MyComp
   return;
 }
 
-void SweetHBK::Graph::getHyperCliqueCE(set<vertex_t, MyComparator> &vertices)
+void SweetHBK::Graph::getHyperCliqueCE(set<vertex_t> &vertices)
 {
-  set<vertex_t> R, X;
+  clique_t R;
+  set<vertex_t> X;
   getHyperCliqueCE(R, vertices, X);
   return;
 }
 
-void SweetHBK::Graph::getHyperCliqueCE(set<vertex_t> &clique, set<vertex_t, MyComparator> &candidates, set<vertex_t> &excluded)
+void SweetHBK::Graph::getHyperCliqueCE(clique_t &clique, set<vertex_t> &candidates, set<vertex_t> &excluded)
 {
   if (gillesCoeurCoeur->g->edgeCount() == 0)
     return;
@@ -218,207 +559,274 @@ void SweetHBK::Graph::getHyperCliqueCE(set<vertex_t> &clique, set<vertex_t, MyCo
   return;
 }
 
-void SweetHBK::Graph::getHyperCliqueCE_HBK(set<vertex_t, MyComparator> &vertices)
+void SweetHBK::Graph::getHyperCliqueCE_HBK(set<vertex_t> &vertices)
 {
-  set<vertex_t> R, X;
+  clique_t R;
+  set<vertex_t> X;
   getHyperCliqueCE_HBK(R, vertices, X);
   return;
 }
 
-void SweetHBK::Graph::getHyperCliqueCE_HBK(set<vertex_t> &clique, set<vertex_t, MyComparator> &candidates, set<vertex_t> &excluded)
+void SweetHBK::Graph::getHyperCliqueCE_HBK(clique_t &clique, set<vertex_t> &candidates, set<vertex_t> &excluded)
 {
   if (gillesCoeurCoeur->g->edgeCount() == 0)
     return;
-  set<set<vertex_t>> cliques(BronKerbosch::cliques);
-  BronKerbosch::cliques.clear();
+  CliqueStore cliques;
+  cliques.swap(BronKerbosch::cliques);
   BronKerbosch::findCliques(clique, candidates, excluded, this);
 
   if (gillesCoeurCoeur->laurent > 2)
   {
-    map<set<vertex_t>, set<id_t>> ncliques;
-    ConstCollection<Hyperedge> hyperedges = gillesCoeurCoeur->g->hyperedges();
-    pair<vector<id_t>, vector<index_t>> ids = Utils::toVectorIds(hyperedges);
-    map<id_t, vector<vertex_t>> mhyperedges = Utils::toMap(hyperedges);
+    vector<pair<clique_t, pool_set<id_t>>> ncliques;
 
-    for (const set<vertex_t> &clique : BronKerbosch::cliques)
+    /* The biggest clique prunes the next ones: they are checked in the order of the input vertices. */
+    for (const size_t position : byOriginal(BronKerbosch::cliques))
     {
-
-      unsigned long order = clique.size();
+      SortedRange<vertex_t> found = BronKerbosch::cliques[position];
+      unsigned long order = found.size();
 
       if (order < BronKerbosch::biggestClique.size())
         continue;
 
       if (order >= gillesCoeurCoeur->laurent)
       {
-        set<id_t> clqEdges = gillesCoeurCoeur->getEdges(ids.second, clique);
+        clique_t clique(found.begin(), found.end());
+        pool_set<id_t> clqEdges = gillesCoeurCoeur->getEdges(clique);
         if (Utils::binom(order, gillesCoeurCoeur->laurent) == clqEdges.size())
         { // a real hyperclique
           if (Globals::maxClique && (BronKerbosch::biggestClique.size() < clique.size()))
             BronKerbosch::biggestClique = clique;
 
-          cliques.insert(clique);
+          cliques.insert(clique.begin(), clique.end());
         }
         else
         {
-          ncliques.emplace(clique, clqEdges);
+          ncliques.emplace_back(clique, clqEdges);
         }
       }
     }
 
     if (ncliques.size() > 0)
     { // at least a non hyperclique
-      BronKerbosch::cliques.clear();
-      for (pair<set<vertex_t>, set<id_t>> p : ncliques)
+      /* The hypercliques of each non hyperclique are searched in a graph of its own hyperedges alone,
+         whose vertices are numbered from 1 in the order of those of the rank. */
+      map<id_t, vector<vertex_t>> mhyperedges = Utils::toMap(gillesCoeurCoeur->g->hyperedges());
+      HBKGraph *rankGraph = gillesCoeurCoeur;
+      CliqueStore found;
+      for (const pair<clique_t, pool_set<id_t>> &p : ncliques)
       {
-        ids = Utils::toVectorIds(gillesCoeurCoeur->g->hyperedges());
-        set<vertex_t, MyComparator> vertices(comp);
-        for (id_t e : ids.first)
+        set<vertex_t> vertices;
+        for (const id_t id : p.second)
+          vertices.insert(mhyperedges[id].begin(), mhyperedges[id].end());
+
+        vector<vertex_t> rankVertices(vertices.begin(), vertices.end());
+        HBKGraph subGraph(*rankGraph, vertices);
+        for (const id_t id : p.second)
         {
-          gillesCoeurCoeur->g->removeEdge(e);
+          vector<vertex_t> elements;
+          for (const vertex_t v : mhyperedges[id])
+            elements.push_back(lower_bound(rankVertices.begin(), rankVertices.end(), v) - rankVertices.begin() + 1);
+          subGraph.addEdge(elements);
         }
-        for (const id_t id : p.second)
+
+        set<vertex_t> candidates;
+        for (vertex_t v = 1; v <= vertices.size(); v++)
+          candidates.insert(candidates.end(), v);
+        size_t biggest = BronKerbosch::biggestClique.size();
+        gillesCoeurCoeur = &subGraph;
+        BronKerbosch::cliques.clear();
+        getHyperClique(candidates);
+        gillesCoeurCoeur = rankGraph;
+
+        for (const SortedRange<vertex_t> clique : BronKerbosch::cliques)
+        {
+          vector<vertex_t> translated;
+          for (const vertex_t v : clique)
+            translated.push_back(rankVertices[v - 1]);
+          found.insert(translated);
+        }
+        if (BronKerbosch::biggestClique.size() > biggest)
         {
-          gillesCoeurCoeur->g->addEdge(mhyperedges[id]);
-          vertices = Utils::set_union(vertices, mhyperedges[id], comp);
+          clique_t translated;
+          for (const vertex_t v : BronKerbosch::biggestClique)
+            translated.insert(rankVertices[v - 1]);
+          BronKerbosch::biggestClique = translated;
         }
-        getHyperClique(vertices);
       }
+      BronKerbosch::cliques.clear();
 
-      set<set<vertex_t>> newCliques;
-      for (const set<vertex_t> &clique : BronKerbosch::cliques)
+      CliqueStore newCliques;
+      for (const SortedRange<vertex_t> clique : found)
       {
-        if (!Utils::is_included(cliques, clique))
+        if (!cliques.includes(clique))
           newCliques.insert(clique);
       }
 
-      for (const set<vertex_t> &clique : newCliques)
+      for (const size_t position : byOriginal(newCliques))
       {
+        SortedRange<vertex_t> clique = newCliques[position];
         if (Globals::maxClique && (BronKerbosch::biggestClique.size() < clique.size()))
         {
-          BronKerbosch::biggestClique = clique;
+          BronKerbosch::biggestClique = clique_t(clique.begin(), clique.end());
         }
         cliques.insert(clique);
       }
-
-      BronKerbosch::cliques = cliques;
     }
-    BronKerbosch::cliques = cliques;
+    BronKerbosch::cliques.swap(cliques);
   }
   else
   {
-    for (set<vertex_t> clique : cliques)
+    for (const SortedRange<vertex_t> clique : cliques)
       BronKerbosch::cliques.insert(clique);
   }
 
   return;
 }
 
-void SweetHBK::Graph::createGilles(unsigned int laurent, unsigned int vertices)
+vector<size_t> SweetHBK::Graph::byOriginal(const CliqueStore &cliques)
 {
-  gillesCoeurCoeur = new HBKGraph(laurent, vertices);
+  CliqueStore originals;
+  for (const SortedRange<vertex_t> clique : cliques)
+    originals.insert(gillesCoeurCoeur->original(clique));
+  return originals.order();
+}
 
+void SweetHBK::Graph::createGilles(unsigned int laurent)
+{
+  RankGraph &rank = rankGraphs[laurent];
+  delete rank.graph;
+
+  /* Only the vertices of the rank are in its graph, numbered from 1. */
+  gillesCoeurCoeur = rank.graph = new HBKGraph(laurent, laurentToVertices[laurent]);
+  rank.edgesMap.clear();
   for (id_t edgeId : laurentToEdges[laurent])
   {
-    vector<vertex_t> vedge = edges[edgeId];
-    id_t givenId = gillesCoeurCoeur->g->addEdge(std::move(vedge));
-    edgesMap[givenId] = edgeId;
+    vector<vertex_t> vedge;
+    vedge.reserve(laurent);
+    for (const vertex_t v : edges[edgeId])
+      vedge.push_back(gillesCoeurCoeur->local(v));
+    id_t givenId = gillesCoeurCoeur->addEdge(std::move(vedge));
+    rank.edgesMap[givenId] = edgeId;
   }
 
-  if (Globals::nodeFilteringValue != NO_FILTER)
-  {
-    laurentFrequences.clear();
-    for (vertex_t v : laurentToVertices[laurent])
+  rank.nbVertices = laurentToVertices[laurent].size();
+  rank.nbEdges = gillesCoeurCoeur->g->edgeCount();
+  rank.vertices.clear();
+  for (vertex_t v = 1; v <= rank.nbVertices; v++)
+    rank.vertices.insert(rank.vertices.end(), v);
+
+  BronKerbosch::cliques.clear();
+  if (rank.nbEdges > laurent /* = Utils::binom(laurent + 1, laurent)*/)
+  { // There may be a clique of size laurent + 1
+    if (Globals::nodeFilteringValue != NO_FILTER)
     {
-      laurentFrequences[v] = gillesCoeurCoeur->g->hyperedges(v).size();
+      CoOccurrenceMatrix coOccurrences(*gillesCoeurCoeur->g);
+
+      // Add option to choose between the two or not
+      if (Globals::nodeFilteringValue == DEGREE_FILTER || Globals::nodeFilteringValue == BOTH_FILTER)
+        filterByFreq(laurent, &rank.vertices, coOccurrences);
+      if (Globals::nodeFilteringValue == COOCCURRENCE_FILTER || Globals::nodeFilteringValue == BOTH_FILTER)
+        filterByCoOccurrences(laurent, &rank.vertices, coOccurrences);
     }
+
+    /* The vertices are numbered in the ordering, which is then the order of the candidate sets. */
+    vector<vertex_t> numbers = orderSeq();
+    gillesCoeurCoeur->renumber(numbers, rank.edgesMap);
+    set<vertex_t> vertices;
+    for (const vertex_t v : rank.vertices)
+      vertices.insert(numbers[v - 1]);
+    rank.vertices.swap(vertices);
+    CliqueStore cliques;
+    for (const SortedRange<vertex_t> clique : BronKerbosch::cliques)
+    {
+      vector<vertex_t> renumbered;
+      for (const vertex_t v : clique)
+        renumbered.push_back(numbers[v - 1]);
+      sort(renumbered.begin(), renumbered.end());
+      cliques.insert(renumbered);
+    }
+    BronKerbosch::cliques.swap(cliques);
   }
+  /* The hyperedges removed by the node filters are cliques. */
+  rank.filtered.swap(BronKerbosch::cliques);
 }
 
-void SweetHBK::Graph::remove(vertex_t v, set<vertex_t> *laurentVertices)
+void SweetHBK::Graph::createRankGraphs()
+{
+  if (rankGraphsOrdering == Globals::orderingValue && rankGraphsNodeFiltering == Globals::nodeFilteringValue)
+    return;
+
+  for (unsigned int laurent = biggestHyperedge; laurent > 1; laurent--)
+    createGilles(laurent);
+  rankGraphsOrdering = Globals::orderingValue;
+  rankGraphsNodeFiltering = Globals::nodeFilteringValue;
+}
+
+void SweetHBK::Graph::remove(vertex_t v, set<vertex_t> *laurentVertices, CoOccurrenceMatrix &coOccurrences)
 {
   ConstCollection<Hyperedge> hypere = gillesCoeurCoeur->g->hyperedges(v);
   for (Hyperedge he : hypere)
   {
-    vector<vertex_t> tmp = he.sortedElements();
-    set<vertex_t> hedge;
-    for (vector<vertex_t>::iterator it = tmp.begin(); it != tmp.end(); it++)
-    {
-      hedge.insert(*it);
-      laurentFrequences[*it]--;
-    }
+    const vector<vertex_t> &hedge = he.sortedElements();
+    coOccurrences.removeEdge(hedge);
     BronKerbosch::cliques.insert(hedge);
-    gillesCoeurCoeur->g->removeEdge(he.id());
+    gillesCoeurCoeur->removeEdge(he.id());
   }
   laurentVertices->erase(v);
 }
 
-void SweetHBK::Graph::filterByFreq(unsigned int laurent, set<vertex_t> *laurentVertices)
+void SweetHBK::Graph::filterByFreq(unsigned int laurent, set<vertex_t> *laurentVertices, CoOccurrenceMatrix &coOccurrences)
 {
 
-  set<pair<vertex_t, unsigned int>, FreqComparator> freqOrd;
-  for (auto freq : laurentFrequences)
+  pool_set<pair<vertex_t, unsigned int>, FreqComparator> freqOrd;
+  for (vertex_t v = 1; v <= gillesCoeurCoeur->g->vertexCount(); v++)
   {
-    freqOrd.insert(make_pair(freq.first, freq.second));
+    freqOrd.insert(make_pair(v, coOccurrences.degree(v)));
   }
 
   for (pair<vertex_t, unsigned int> f : freqOrd)
   {
     // If the vertex is not in at least laurent edges then it cannot be in a clique.
     // We can thus remove it as a candidate and all the edges it is part of.
-    if (laurentFrequences[f.first] < laurent)
+    if (coOccurrences.degree(f.first) < laurent)
     {
-      remove(f.first, laurentVertices);
+      remove(f.first, laurentVertices, coOccurrences);
     }
   }
 }
 
-void SweetHBK::Graph::filterByCoOccurrences(unsigned int laurent, set<vertex_t> *laurentVertices)
+void SweetHBK::Graph::filterByCoOccurrences(unsigned int laurent, set<vertex_t> *laurentVertices, CoOccurrenceMatrix &coOccurrences)
 {
 
-  set<pair<vertex_t, unsigned int>, FreqComparator> freqOrd;
-  for (auto freq : laurentFrequences)
+  pool_set<pair<vertex_t, unsigned int>, FreqComparator> freqOrd;
+  for (vertex_t v = 1; v <= gillesCoeurCoeur->g->vertexCount(); v++)
   {
-    freqOrd.insert(make_pair(freq.first, freq.second));
+    freqOrd.insert(make_pair(v, coOccurrences.degree(v)));
   }
 
   for (pair<vertex_t, unsigned int> f : freqOrd)
   {
-    if (laurentFrequences[f.first] < laurent)
+    if (coOccurrences.degree(f.first) < laurent)
     {
       // cout << "(removed) " << flush;
-      remove(f.first, laurentVertices);
+      remove(f.first, laurentVertices, coOccurrences);
     }
     // Otherwise, if a vertex does not have at least laurent - 1 occurrences with
     // at least laurent negihbours then it cannot be in a clique.
     // We can thus remove it as a candidate and all the edges it is part of.
-    else
+    else if (coOccurrences.nbNeighbours(f.first) < laurent)
     {
-      set<pair<vertex_t, unsigned int>, FreqComparator> coOcurOrd;
-      set<id_t> hyperedges = Utils::toSetId(gillesCoeurCoeur->g->hyperedges(f.first));
-      for (vertex_t v : gillesCoeurCoeur->g->neighbors(f.first))
-      {
-        set<id_t> vhyperedges = Utils::toSetId(gillesCoeurCoeur->g->hyperedges(v));
-        coOcurOrd.insert(make_pair(v, Utils::set_intersection(hyperedges, vhyperedges).size()));
-      }
-
-      if (coOcurOrd.size() < laurent)
-      {
-        remove(f.first, laurentVertices);
-      }
-      else
-      {
-        set<pair<vertex_t, id_t>, FreqComparator>::iterator it = prev(coOcurOrd.end(), laurent);
-        if (it->second < laurent - 1)
-        {
-          // cout << "(removed occ) " << flush;
-          remove(f.first, laurentVertices);
-        }
-      }
+      remove(f.first, laurentVertices, coOccurrences);
+    }
+    else if (coOccurrences.greatest(f.first, laurent) < laurent - 1)
+    {
+      // cout << "(removed occ) " << flush;
+      remove(f.first, laurentVertices, coOccurrences);
     }
   }
 }
 
-double SweetHBK::Graph::enumerateHyperCliques(void (SweetHBK::Graph::*func)(set<vertex_t, MyComparator> &))
+double SweetHBK::Graph::enumerateHyperCliques(void (SweetHBK::Graph::*func)(set<vertex_t> &))
 {
   BronKerbosch::nbCallToBK = 0;
   Globals::timedout = false;
@@ -435,39 +843,30 @@ double SweetHBK::Graph::enumerateHyperCliques(void (SweetHBK::Graph::*func)(set<
     cout << ", \"cliques\": [";
   chrono::high_resolution_clock::time_point all_start = chrono::high_resolution_clock::now();
   vector<Clique *> all_cliques;
+  unsigned long nbCliques = 0;
   int previous = 0;
 
   // cout << "blu" << endl;
 
-  /* Construct the graph which link 'laurent' variables if and only if they all appear negatively in a 'laurent'-clause */
+  /* The graphs linking 'laurent' variables if and only if they all appear negatively in a 'laurent'-clause
+     are built beforehand (see createRankGraphs). */
   while (laurent != 1 && !Globals::timedout)
   {
-    BronKerbosch::cliques.clear();
-    createGilles(laurent, vertices.size());
-    set<vertex_t> laurentVertices = laurentToVertices[laurent];
+    const RankGraph &rank = rankGraphs[laurent];
+    gillesCoeurCoeur = rank.graph;
+    edgesMap = rank.edgesMap;
+    BronKerbosch::cliques = rank.filtered;
 
     chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
-    unsigned int n = laurentVertices.size(); // gillesCoeurCoeur->g->vertices().size();
-    unsigned int m = gillesCoeurCoeur->g->edgeCount();
+    unsigned int n = rank.nbVertices;
+    unsigned int m = rank.nbEdges;
     // cout << "n : " << n << ", m : " << m << endl;
 
     if (m > 0)
     {
       if (m > laurent /* = Utils::binom(laurent + 1, laurent)*/)
       { // There may be a clique of size laurent + 1
-
-        // Add option to choose between the two or not
-        if (Globals::nodeFilteringValue == DEGREE_FILTER || Globals::nodeFilteringValue == BOTH_FILTER)
-          filterByFreq(laurent, &laurentVertices);
-        if (Globals::nodeFilteringValue == COOCCURRENCE_FILTER || Globals::nodeFilteringValue == BOTH_FILTER)
-          filterByCoOccurrences(laurent, &laurentVertices);
-
-        orderSeq(laurentVertices);
-        set<vertex_t, MyComparator> candidates(comp);
-        for (vertex_t v : laurentVertices)
-        {
-          candidates.insert(v);
-        }
+        set<vertex_t> candidates(rank.vertices);
         (this->*func)(candidates);
       }
       else
@@ -475,17 +874,13 @@ double SweetHBK::Graph::enumerateHyperCliques(void (SweetHBK::Graph::*func)(set<
         // Each hyperedge is a clique
         for (const Hyperedge &e : gillesCoeurCoeur->g->hyperedges())
         {
-          vector<vertex_t> tmp = e.sortedElements();
-          set<vertex_t> hedge;
-          for (const vertex_t v : tmp)
-            hedge.insert(v);
-
+          const vector<vertex_t> &hedge = e.sortedElements();
           BronKerbosch::cliques.insert(hedge);
 
           /* If each hyperedge is a clique, then the biggest hyperedge is necessary the biggest clique. */
           if (Globals::maxClique && (BronKerbosch::biggestClique.size() < hedge.size()))
           {
-            BronKerbosch::biggestClique = hedge;
+            BronKerbosch::biggestClique = clique_t(hedge.begin(), hedge.end());
             break;
           }
         }
@@ -495,15 +890,33 @@ double SweetHBK::Graph::enumerateHyperCliques(void (SweetHBK::Graph::*func)(set<
       int l10 = ceil(log10(extractionTime));
       l10 = l10 <= 0 ? 1 : l10;
 
-      for (set<vertex_t> clique : BronKerbosch::cliques)
+      /* The cliques are reported with the vertices of the input, and in their order. */
+      CliqueStore cliques;
+      for (const SortedRange<vertex_t> clique : BronKerbosch::cliques)
+        cliques.insert(gillesCoeurCoeur->original(clique));
+      vector<size_t> order = cliques.order();
+      BronKerbosch::biggestClique = gillesCoeurCoeur->original(BronKerbosch::biggestClique);
+      for (const size_t position : order)
       {
+        SortedRange<vertex_t> original = cliques[position];
         /* If each hyperedge is a clique, then the biggest hyperedge is necessary the biggest clique. */
-        if (Globals::maxClique && (BronKerbosch::biggestClique.size() < clique.size()))
+        if (Globals::maxClique && (BronKerbosch::biggestClique.size() < original.size()))
+        {
+          BronKerbosch::biggestClique = clique_t(original.begin(), original.end());
+        }
+        /* Only the cardinality constraints need the hyperedges of the cliques. */
+        if (Globals::cardinality)
         {
-          BronKerbosch::biggestClique = clique;
+          SortedRange<vertex_t> clique = BronKerbosch::cliques[position];
+          set<id_t> cliqueEdges;
+          for (const id_t e : gillesCoeurCoeur->getEdges(clique_t(clique.begin(), clique.end())))
+            cliqueEdges.insert(edgesMap[e]);
+          all_cliques.push_back(new Clique(laurent, clique_t(original.begin(), original.end()), cliqueEdges));
         }
-        all_cliques.push_back(new Clique(laurent, clique, gillesCoeurCoeur->getEdges(clique)));
       }
+      nbCliques += cliques.size();
+      cliques.reorder(order);
+      BronKerbosch::cliques.swap(cliques);
 
       if (Globals::print && !Globals::json)
       {
@@ -547,15 +960,16 @@ double SweetHBK::Graph::enumerateHyperCliques(void (SweetHBK::Graph::*func)(set<
         BronKerbosch::cleanBiggest();
       }
     }
+    NodePool::release();
     --laurent;
   }
   if (Globals::json)
   {
-    cout << "], \"totalcliques\": " << all_cliques.size() << ", \"totalcalls\": " << BronKerbosch::nbCallToBK << ", \"timedout\": " << Globals::timedout;
+    cout << "], \"totalcliques\": " << nbCliques << ", \"totalcalls\": " << BronKerbosch::nbCallToBK << ", \"timedout\": " << Globals::timedout;
   }
   else
   {
-    cout << "c | total cliques found: " << setw(11) << all_cliques.size() << setw(LENGTH - 33) << "|" << endl;
+    cout << "c | total cliques found: " << setw(11) << nbCliques << setw(LENGTH - 33) << "|" << endl;
     cout << "c | total nb calls to BK: " << setw(10) << BronKerbosch::nbCallToBK << setw(LENGTH - 33) << "|" << endl;
     cout << "c | timedout: " << setw(22) << Globals::timedout << setw(LENGTH - 33) << "|" << endl;
   }
@@ -571,14 +985,17 @@ double SweetHBK::Graph::enumerateHyperCliques(void (SweetHBK::Graph::*func)(set<
     set<CardinalityConstraint *> unitscardinalities;
     map<id_t, vertex_t> units;
     map<vertex_t, CardinalityConstraint *> tounitscardinalities;
-    ConstCollection<Hyperedge> hyperedges = gillesCoeurCoeur->g->hyperedges();
-    pair<vector<Hyperedge>, vector<id_t>> edg = Utils::toVectors(hyperedges);
-    for (auto e : edg.second)
-      gillesCoeurCoeur->g->removeEdge(e);
+    /* The graph of all the hyperedges is left for the non-uniform enumeration. */
+    wholeGraph->laurent = gillesCoeurCoeur->laurent;
+    gillesCoeurCoeur = wholeGraph;
+    if (wholeEdgesMap.empty())
+    {
+      for (auto edge : edges)
+        wholeEdgesMap[wholeGraph->addEdge(edge.second)] = edge.first;
+    }
+    edgesMap = wholeEdgesMap;
     for (auto edge : edges)
     {
-      id_t givenId = gillesCoeurCoeur->g->addEdge(edge.second);
-      edgesMap[givenId] = edge.first;
       if (edge.second.size() == 1)
       {
         units[edge.first] = edge.second[0];
@@ -589,13 +1006,13 @@ double SweetHBK::Graph::enumerateHyperCliques(void (SweetHBK::Graph::*func)(set<
       cout << "c | found cliques... " << setw(LENGTH - 18) << "|" << endl;
     for (unsigned long i = 0; i < all_cliques.size(); i++)
     {
-      set<CardinalityConstraint *> tmp = CardinalityConstraint::toCardinalityConstraint(all_cliques[i], edgesMap);
+      set<CardinalityConstraint *> tmp = CardinalityConstraint::toCardinalityConstraint(all_cliques[i]);
       for (CardinalityConstraint *card : tmp)
       {
         if (Globals::verbose)
         {
           card->print();
-          all_cliques[i]->print(edgesMap);
+          all_cliques[i]->print();
         }
         cardinalities.insert(card);
       }
@@ -681,6 +1098,9 @@ double SweetHBK::Graph::enumerateHyperCliques(void (SweetHBK::Graph::*func)(set<
   double all_extractionTime = ((all_end - all_start).count() / 1e9);
   int l10 = ceil(log10(all_extractionTime));
   l10 = l10 <= 0 ? 1 : l10;
+  for (Clique *clique : all_cliques)
+    delete clique;
+
   if (Globals::json)
     cout << ", \"bktotaltime\": " << all_extractionTime;
   else
@@ -689,157 +1109,144 @@ double SweetHBK::Graph::enumerateHyperCliques(void (SweetHBK::Graph::*func)(set<
   return (all_extractionTime);
 }
 
-set<vertex_t> SweetHBK::Graph::cliqueNeighbourhood(set<vertex_t> &clique, set<vertex_t, MyComparator> &suburbs)
+template <typename F>
+void SweetHBK::Graph::forEachCliqueNeighbour(const clique_t &clique, SortedRange<vertex_t> suburbs, F f)
 {
-  set<vertex_t> result;
   int n = clique.size();
+  size_t cliqueEdges = gillesCoeurCoeur->countEdges(clique);
+  bool isLinked = gillesCoeurCoeur->linked();
+  if (isLinked)
+    gillesCoeurCoeur->countLinks(clique, linked);
 
   for (const vertex_t v : suburbs)
   {
     if (gillesCoeurCoeur->isNeighbour(clique, v))
     {
-      set<vertex_t> singleton;
-      singleton.insert(v);
-
-      set<vertex_t> possibleClique = Utils::set_union(clique, singleton);
-
-      set<id_t> possibleCliqueEdges = gillesCoeurCoeur->getEdges(possibleClique);
-
-      if (possibleCliqueEdges.size() >= Utils::binom(n + 1, gillesCoeurCoeur->laurent))
+      // The edges of clique U {v} are those of the clique, and those containing v
+      size_t vEdges;
+      if (isLinked)
       {
-        result.insert(v);
+        pair<vector<vertex_t>::const_iterator, vector<vertex_t>::const_iterator> range = equal_range(linked.begin(), linked.end(), v);
+        vEdges = range.second - range.first;
       }
+      else
+        vEdges = gillesCoeurCoeur->countEdges(clique, v);
+      if (cliqueEdges + vEdges >= Utils::binom(n + 1, gillesCoeurCoeur->laurent) && !f(v))
+        return;
     }
   }
-  return result;
 }
 
-set<vertex_t, MyComparator> SweetHBK::Graph::ordCliqueNeighbourhood(set<vertex_t> &clique, set<vertex_t, MyComparator> &suburbs)
+void SweetHBK::Graph::cliqueNeighbourhood(const clique_t &clique, vector<vertex_t> &suburbs)
 {
-  set<vertex_t, MyComparator> result(comp);
-  int n = clique.size();
-
-  for (const vertex_t v : suburbs)
-  {
-    if (gillesCoeurCoeur->isNeighbour(clique, v))
-    {
-      set<vertex_t> singleton;
-      singleton.insert(v);
-
-      set<vertex_t> possibleClique = Utils::set_union(clique, singleton);
-
-      set<id_t> possibleCliqueEdges = gillesCoeurCoeur->getEdges(possibleClique);
-
-      if (possibleCliqueEdges.size() >= Utils::binom(n + 1, gillesCoeurCoeur->laurent))
-      {
-        result.insert(v);
-      }
-    }
-  }
-  return result;
+  // The vertices kept are written behind those read
+  size_t kept = 0;
+  forEachCliqueNeighbour(clique, SortedRange<vertex_t>(suburbs.data(), suburbs.data() + suburbs.size()), [&suburbs, &kept](vertex_t v)
+                         {
+                           suburbs[kept++] = v;
+                           return true; });
+  suburbs.resize(kept);
 }
 
-set<vertex_t> SweetHBK::Graph::nonUniformNeighbourhood(set<vertex_t> &clique, set<vertex_t> &suburbs)
+bool SweetHBK::Graph::hasCliqueNeighbour(const clique_t &clique, SortedRange<vertex_t> suburbs)
 {
-  set<vertex_t> result;
+  bool found = false;
+  forEachCliqueNeighbour(clique, suburbs, [&found](vertex_t)
+                         {
+                           found = true;
+                           return false; });
+  return found;
+}
 
+bool SweetHBK::Graph::hasNonUniformNeighbour(const clique_t &clique, SortedRange<vertex_t> suburbs)
+{
   for (const vertex_t v : suburbs)
   {
     if (gillesCoeurCoeur->isNeighbour(clique, v))
     {
-      set<vertex_t> singleton;
-      singleton.insert(v);
-
-      set<vertex_t> possibleClique = Utils::set_union(clique, singleton);
+      clique_t possibleClique(clique);
+      possibleClique.insert(v);
 
       if (gillesCoeurCoeur->isNonUniformClique(possibleClique))
       {
-        result.insert(v);
+        return true;
       }
     }
   }
-  return result;
+  return false;
 }
 
-void SweetHBK::Graph::candidateBloomFilter(set<vertex_t> &clique, set<vertex_t, MyComparator> &suburbs)
+void SweetHBK::Graph::candidateBloomFilter(const clique_t &clique, vector<vertex_t> &suburbs)
 {
-  set<vertex_t> tmp(suburbs.begin(), suburbs.end());
-  suburbs.clear();
   int n = clique.size();
 
-  for (const vertex_t v : tmp)
-  {
-    if (gillesCoeurCoeur->isNeighbour(clique, v))
-    {
-      set<vertex_t> possibleClique(clique);
-      possibleClique.insert(v);
+  suburbs.erase(remove_if(suburbs.begin(), suburbs.end(), [this, &clique, n](vertex_t v)
+                          {
+                            if (!gillesCoeurCoeur->isNeighbour(clique, v))
+                              return true;
+                            clique_t possibleClique(clique);
+                            possibleClique.insert(v);
 
-      size_t nb = bloom->getNb(possibleClique, gillesCoeurCoeur->laurent);
+                            clique_t original = gillesCoeurCoeur->original(possibleClique);
+                            size_t nb = bloom->getNb(vector<vertex_t>(original.begin(), original.end()), gillesCoeurCoeur->laurent);
 
-      if (nb >= Utils::binom(n + 1, gillesCoeurCoeur->laurent))
-      {
-        suburbs.insert(v);
-      }
-    }
-  }
+                            return nb < Utils::binom(n + 1, gillesCoeurCoeur->laurent); }),
+                suburbs.end());
 }
 
-void SweetHBK::Graph::candidateIncrementalFilter(set<vertex_t> &clique, set<vertex_t, MyComparator> &suburbs, vertex_t lastAdded)
+void SweetHBK::Graph::candidateIncrementalFilter(const clique_t &clique, vector<vertex_t> &suburbs, vertex_t lastAdded)
 {
   if (!clique.size())
   {
-    suburbs = Utils::set_intersection(gillesCoeurCoeur->g->neighbors(lastAdded), suburbs, comp);
+    gillesCoeurCoeur->retainNeighbors(suburbs, lastAdded);
   }
   else if (clique.size() < gillesCoeurCoeur->laurent - 2)
   {
-    set<vertex_t> vclique(clique.begin(), clique.end());
+    clique_t vclique(clique);
     vclique.insert(lastAdded);
-    suburbs = ordCliqueNeighbourhood(vclique, suburbs);
+    cliqueNeighbourhood(vclique, suburbs);
   }
   else if (clique.size() + suburbs.size() + 1 == gillesCoeurCoeur->laurent)
   {
-    set<vertex_t> tmp(clique);
-    tmp.insert(suburbs.begin(), suburbs.end());
+    clique_t tmp(clique);
+    for (const vertex_t s : suburbs)
+      tmp.insert(s);
     tmp.insert(lastAdded);
-    if (gillesCoeurCoeur->getEdges(tmp).size() > 0)
+    if (gillesCoeurCoeur->countEdges(tmp) > 0)
       return;
     else
       suburbs.clear();
   }
+  else if (gillesCoeurCoeur->linked())
+  {
+    // The suburbs completing each (rank-2)-subset of clique, with lastAdded, into a hyperedge
+    gillesCoeurCoeur->completions(clique, lastAdded, linked);
+    Utils::intersect_with(suburbs, linked);
+  }
   else
   {
-    set<vertex_t> neighbor_of_v;
-
     vector<vertex_t> a(clique.begin(), clique.end());
 
-    set<vertex_t> subset;
-    vector<set<vertex_t>> res;
+    clique_t subset;
+    vector<clique_t> res;
 
     /* Let us generate all the subset of size rank-1 from clique.
      * With this we will add, the lastAdded and each subsurbs to check if the hyperedge exists.
      */
     Utils::generateSubSets(a, gillesCoeurCoeur->laurent - 2, 0, subset, res);
 
-    for (auto s : suburbs)
-    {
-      bool toAdd = true;
-      for (auto test : res)
-      {
-        test.insert(s);
-        test.insert(lastAdded);
-
-        if (gillesCoeurCoeur->getEdges(test).size() == 0)
-        {
-          toAdd = false;
-          break;
-        }
-      }
-
-      if (toAdd)
-        neighbor_of_v.insert(s);
-    }
-
-    suburbs = Utils::set_intersection(neighbor_of_v, suburbs, comp);
+    suburbs.erase(remove_if(suburbs.begin(), suburbs.end(), [this, &res, lastAdded](vertex_t s)
+                            {
+                              for (auto test : res)
+                              {
+                                test.insert(s);
+                                test.insert(lastAdded);
+
+                                if (gillesCoeurCoeur->countEdges(test) == 0)
+                                  return true;
+                              }
+                              return false; }),
+                  suburbs.end());
   }
 }
 
@@ -848,55 +1255,44 @@ void SweetHBK::Graph::candidateIncrementalFilter(set<vertex_t> &clique, set<vert
  * to approximate the set of candidates.
  * We assume that we are in a r-uniform hypergraph and that |clique| + |suburbs| >= r.
  */
-void SweetHBK::Graph::candidateCliqueFilter(set<vertex_t> &clique, set<vertex_t, MyComparator> &suburbs)
+void SweetHBK::Graph::candidateCliqueFilter(const clique_t &clique, vector<vertex_t> &suburbs)
 {
-  set<vertex_t> s;
-  for (vertex_t v : suburbs)
-    s.insert(v);
-  set<vertex_t> all = Utils::set_union(clique, s);
-  set<vertex_t, MyComparator> ordall = Utils::set_union(clique, suburbs, comp);
+  vector<vertex_t> all;
+  Utils::set_union(suburbs, clique, all);
 
-  set<vertex_t> R, X;
-  set<vertex_t, MyComparator> P(comp);
+  clique_t R;
+  set<vertex_t> X, P;
 
-  for (const Hyperedge &hedge : gillesCoeurCoeur->g->hyperedges())
+  for (size_t e = 0; e < gillesCoeurCoeur->edgeCount(); e++)
   {
-
-    const vector<vertex_t> vertices = hedge.sortedElements();
-    vector<vertex_t> tmp(vertices.size());
-    vector<vertex_t>::iterator it;
-
-    it = set_intersection(vertices.begin(), vertices.end(), all.begin(), all.end(), tmp.begin());
-
-    tmp.resize(it - tmp.begin());
-    if (tmp.size() == vertices.size()) // no vertex not in (clique U suburbs)
+    SortedRange<vertex_t> vertices = gillesCoeurCoeur->edge(e);
+    if (includes(all.begin(), all.end(), vertices.begin(), vertices.end())) // no vertex not in (clique U suburbs)
       for (const vertex_t v : vertices)
         P.insert(v);
   }
 
   int tmpCalls = BronKerbosch::nbCallToBK;
-  set<set<vertex_t>> tmpCliques(BronKerbosch::cliques);
+  CliqueStore tmpCliques;
+  tmpCliques.swap(BronKerbosch::cliques);
 
   BronKerbosch::nbCallToBK = 0;
-  BronKerbosch::cliques.clear();
   BronKerbosch::findCliques(R, P, X, this);
 
   set<vertex_t> all_node_in_cliques;
-  for (const set<vertex_t> &clq : BronKerbosch::cliques)
+  for (const SortedRange<vertex_t> clq : BronKerbosch::cliques)
   {
-    all_node_in_cliques = Utils::set_union(clq, all_node_in_cliques);
+    all_node_in_cliques.insert(clq.begin(), clq.end());
   }
 
-  suburbs = Utils::set_intersection(suburbs, all_node_in_cliques, comp);
+  Utils::intersect_with(suburbs, all_node_in_cliques);
 
   BronKerbosch::nbCallToBK = tmpCalls;
-  BronKerbosch::cliques = tmpCliques;
+  BronKerbosch::cliques.swap(tmpCliques);
 }
 
-void SweetHBK::Graph::candidateNeighbourhoodFilter(set<vertex_t, MyComparator> &suburbs, vertex_t lastAdded)
+void SweetHBK::Graph::candidateNeighbourhoodFilter(vector<vertex_t> &suburbs, vertex_t lastAdded)
 {
-  ConstCollection<vertex_t> v_neighbors = gillesCoeurCoeur->g->neighbors(lastAdded);
-  suburbs = Utils::set_intersection(v_neighbors, suburbs, comp);
+  gillesCoeurCoeur->retainNeighbors(suburbs, lastAdded);
 }
 
 void SweetHBK::Graph::enumerateNonUniformCliques()
@@ -905,16 +1301,38 @@ void SweetHBK::Graph::enumerateNonUniformCliques()
   BronKerbosch::nbCallToBK = 0;
   BronKerbosch::cliques.clear();
 
+  /* The enumeration runs on its own graph of every vertex of the input, with the hyperedges of the graph left
+     by the last enumeration: the graphs of the ranks are shared and stay as they are. */
+  HBKGraph *source = gillesCoeurCoeur;
+  map<id_t, id_t> sourceEdgesMap;
+  sourceEdgesMap.swap(edgesMap);
+  HBKGraph graph(biggestHyperedge, vertices.size());
+  for (const Hyperedge &e : source->g->hyperedges())
+  {
+    vector<vertex_t> vedge;
+    for (const vertex_t v : e.sortedElements())
+      vedge.push_back(source->original(v));
+    sort(vedge.begin(), vedge.end());
+    id_t givenId = graph.addEdge(std::move(vedge));
+    edgesMap[givenId] = sourceEdgesMap[e.id()];
+  }
+  gillesCoeurCoeur = &graph;
+  nonUniformCliques();
+  gillesCoeurCoeur = source;
+  edgesMap.swap(sourceEdgesMap);
+}
+
+void SweetHBK::Graph::nonUniformCliques()
+{
   unsigned int n = gillesCoeurCoeur->g->vertices().size();
-  gillesCoeurCoeur->laurent = biggestHyperedge;
 
   if (gillesCoeurCoeur->g->edgeCount() == 0)
     return;
 
   chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
 
-  set<vertex_t> R, X;
-  set<vertex_t, MyComparator> P(comp);
+  clique_t R;
+  set<vertex_t> X, P;
 
   for (const vertex_t i : gillesCoeurCoeur->g->vertices())
   {
@@ -933,6 +1351,12 @@ void SweetHBK::Graph::enumerateNonUniformCliques()
   int l10 = ceil(log10(extractionTime));
   l10 = l10 < 0 ? 1 : l10;
 
+  CliqueStore cliques;
+  for (const SortedRange<vertex_t> clique : BronKerbosch::cliques)
+    cliques.insert(gillesCoeurCoeur->original(clique));
+  cliques.reorder(cliques.order());
+  BronKerbosch::cliques.swap(cliques);
+
   if (Globals::print)
   {
     cout << "c | ";
@@ -24,10 +24,13 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include "HBKGraph.h"
 #include "BloomFilter.h"
+#include "CoOccurrenceMatrix.h"
 #include "CardinalityConstraint.h"
 #include "Clique.h"
+#include "CliqueStore.h"
 #include "Statc.h"
 #include "Stath.h"
+#include "Snapshot.h"
 #include <sstream>
 #include <string>
 #include <iostream>
@@ -39,29 +42,6 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include <vector>
 #include <algorithm>
 
-struct MyComparator
-{
-  vector<vertex_t> sequence;
-
-  MyComparator() : sequence() {}
-
-  MyComparator(vector<vertex_t> val_vec) : sequence(val_vec) {}
-
-  void setSequence(vector<vertex_t> val_vec)
-  {
-    sequence.clear();
-    for (size_t i = 0; i < val_vec.size(); i++)
-    {
-      sequence.push_back(val_vec[i]);
-    }
-  }
-
-  bool operator()(const vertex_t i1, const vertex_t i2) const
-  {
-    return sequence[i1 - 1] < sequence[i2 - 1];
-  }
-};
-
 struct FreqComparator
 {
   bool operator()(const pair<vertex_t, unsigned int> i1, const pair<vertex_t, unsigned int> i2) const
@@ -74,6 +54,23 @@ struct FreqComparator
 
 namespace SweetHBK
 {
+  /**
+   * The graph of a rank, built once and shared by all the enumeration methods: its node filtered
+   * hyperedges, the hyperedges removed by the node filters (each one is a clique) and the remaining
+   * vertices, numbered in the chosen ordering.
+   */
+  struct RankGraph
+  {
+    HBKGraph *graph;
+    map<id_t, id_t> edgesMap;
+    unsigned int nbVertices;
+    unsigned int nbEdges;
+    CliqueStore filtered;
+    set<vertex_t> vertices;
+
+    RankGraph() : graph(NULL), nbVertices(0), nbEdges(0) {}
+  };
+
   class Graph
   {
 
@@ -82,51 +79,97 @@ namespace SweetHBK
     map<id_t, id_t> edgesMap;
     map<id_t, set<id_t>> laurentToEdges;
     map<id_t, set<vertex_t>> laurentToVertices;
-    map<vertex_t, unsigned int> laurentFrequences;
     set<vertex_t> vertices;
 
+    unsigned int nbHyperedges;
     unsigned int biggestHyperedge;
     HBKGraph *gillesCoeurCoeur;
     BloomFilter *bloom;
 
-    MyComparator comp;
-
+    /**
+     * Reads the hypergraph from the standard input.
+     * A DIMACS CNF input (`p cnf` problem line) is read as the hypergraph of its clauses,
+     * the literal v being the vertex 2v and -v the vertex 2v+1.
+     */
     Graph();
 
+    /**
+     * Reads the hypergraph from an in-memory text buffer (e.g. a memory-mapped file).
+     * The integers are decoded in place, without any intermediate string.
+     * With several parsing threads, the hyperedge lines are decoded in parallel.
+     */
+    Graph(const char *begin, const char *end);
+
+    /**
+     * Reads the hypergraph block by block from `input` (e.g. a decompressed stream),
+     * decoding the integers in place like the in-memory parser.
+     */
+    Graph(streambuf *input);
+
+    /**
+     * Loads the hypergraph from a binary snapshot, without any parsing.
+     */
+    Graph(const Snapshot &snapshot);
+
     ~Graph()
     {
-      delete gillesCoeurCoeur;
+      for (auto &rank : rankGraphs)
+        delete rank.second.graph;
+      delete wholeGraph;
       delete bloom;
+      delete stats;
     }
 
-    void orderSeq(set<vertex_t> vertices);
+    /**
+     * Returns the position (from 1) of each vertex of `gillesCoeurCoeur` in the chosen ordering. The vertices
+     * removed by the node filters are left without hyperedges, and are ordered as such.
+     */
+    vector<vertex_t> orderSeq();
 
     map<id_t, vertex_t> getUnit();
 
-    void getHyperClique(set<vertex_t, MyComparator> &vertices);
-    void getHyperClique(set<vertex_t> &clique, set<vertex_t, MyComparator> &candidates,
+    void getHyperClique(set<vertex_t> &vertices);
+    void getHyperClique(clique_t &clique, set<vertex_t> &candidates,
                         set<vertex_t> &excluded);
 
-    void getHyperCliqueCE(set<vertex_t, MyComparator> &vertices);
-    void getHyperCliqueCE(set<vertex_t> &clique, set<vertex_t, MyComparator> &candidates,
+    void getHyperCliqueCE(set<vertex_t> &vertices);
+    void getHyperCliqueCE(clique_t &clique, set<vertex_t> &candidates,
                           set<vertex_t> &excluded);
 
-    void getHyperCliqueCE_HBK(set<vertex_t, MyComparator> &vertices);
-    void getHyperCliqueCE_HBK(set<vertex_t> &clique, set<vertex_t, MyComparator> &candidates,
+    void getHyperCliqueCE_HBK(set<vertex_t> &vertices);
+    void getHyperCliqueCE_HBK(clique_t &clique, set<vertex_t> &candidates,
                               set<vertex_t> &excluded);
 
-    double enumerateHyperCliques(void (Graph::*func)(set<vertex_t, MyComparator> &));
+    /**
+     * Builds the graph of each rank with the current ordering and node filter, unless they were already built with
+     * them. The enumerations of the hypercliques run on these graphs.
+     */
+    void createRankGraphs();
 
-    set<vertex_t> cliqueNeighbourhood(set<vertex_t> &clique, set<vertex_t, MyComparator> &suburbs);
-    set<vertex_t, MyComparator> ordCliqueNeighbourhood(set<vertex_t> &clique, set<vertex_t, MyComparator> &suburbs);
+    double enumerateHyperCliques(void (Graph::*func)(set<vertex_t> &));
 
-    void candidateBloomFilter(set<vertex_t> &clique, set<vertex_t, MyComparator> &suburbs);
-    void candidateIncrementalFilter(set<vertex_t> &clique, set<vertex_t, MyComparator> &suburbs, vertex_t lastAdded);
-    void candidateCliqueFilter(set<vertex_t> &clique, set<vertex_t, MyComparator> &suburbs);
-    void candidateNeighbourhoodFilter(set<vertex_t, MyComparator> &suburbs, vertex_t lastAdded);
+    /**
+     * Keeps in the sorted `suburbs` only the vertices extending `clique` into a hyperclique.
+     */
+    void cliqueNeighbourhood(const clique_t &clique, vector<vertex_t> &suburbs);
+
+    /**
+     * Returns `true` if a vertex of the sorted `suburbs` extends `clique` into a hyperclique.
+     */
+    bool hasCliqueNeighbour(const clique_t &clique, SortedRange<vertex_t> suburbs);
+
+    /* The candidate filters keep in the sorted `suburbs` the vertices which may extend `clique`. */
+    void candidateBloomFilter(const clique_t &clique, vector<vertex_t> &suburbs);
+    void candidateIncrementalFilter(const clique_t &clique, vector<vertex_t> &suburbs, vertex_t lastAdded);
+    void candidateCliqueFilter(const clique_t &clique, vector<vertex_t> &suburbs);
+    void candidateNeighbourhoodFilter(vector<vertex_t> &suburbs, vertex_t lastAdded);
 
     void enumerateNonUniformCliques();
-    set<vertex_t> nonUniformNeighbourhood(set<vertex_t> &clique, set<vertex_t> &suburbs);
+
+    /**
+     * Returns `true` if a vertex of the sorted `suburbs` extends `clique` into a non-uniform clique.
+     */
+    bool hasNonUniformNeighbour(const clique_t &clique, SortedRange<vertex_t> suburbs);
 
     void print()
     {
@@ -145,10 +188,50 @@ namespace SweetHBK
     }
 
   private:
-    void createGilles(unsigned int laurent, unsigned int vertices);
-    void remove(vertex_t v, set<vertex_t> *laurentVertices);
-    void filterByFreq(unsigned int laurent, set<vertex_t> *laurentVertices);
-    void filterByCoOccurrences(unsigned int laurent, set<vertex_t> *laurentVertices);
+    Stath *stats;
+
+    /** The graph of all the vertices (and of all the hyperedges after -m), and the ids of its hyperedges in the input. */
+    HBKGraph *wholeGraph;
+    map<id_t, id_t> wholeEdgesMap;
+
+    /** The graph of each rank, and the ordering and node filtering they were built with. */
+    map<unsigned int, RankGraph> rankGraphs;
+    unsigned int rankGraphsOrdering;
+    unsigned int rankGraphsNodeFiltering;
+
+    /** The vertices linked to the clique, or completing it, reused by the neighbourhoods and the filters. */
+    vector<vertex_t> linked;
+
+    /**
+     * Calls `f` on each vertex of the sorted `suburbs` extending `clique` into a hyperclique, until it returns `false`.
+     */
+    template <typename F>
+    void forEachCliqueNeighbour(const clique_t &clique, SortedRange<vertex_t> suburbs, F f);
+
+    /** Whether the input is a DIMACS CNF file, whose clauses become the hyperedges. */
+    bool cnf;
+    /** The number of clauses read so far, and the literals of the clause being read. */
+    id_t nbClauses;
+    vector<vertex_t> clause;
+
+    void init();
+    void setSize(unsigned int nbVertices, unsigned int nbEdges);
+    void addHyperedge(id_t id, vector<vertex_t> &elements);
+    void readLines(const char *begin, const char *end, bool chunked);
+    void readChunks(const char *begin, const char *end);
+    void readClauses(const char *begin, const char *end);
+    void addClause();
+    void parsingDone();
+
+    /** Returns the positions of the given cliques of `gillesCoeurCoeur` in the order of their vertices of the input. */
+    vector<size_t> byOriginal(const CliqueStore &cliques);
+
+    void createGilles(unsigned int laurent);
+    /** The non-uniform enumeration on `gillesCoeurCoeur`. */
+    void nonUniformCliques();
+    void remove(vertex_t v, set<vertex_t> *laurentVertices, CoOccurrenceMatrix &coOccurrences);
+    void filterByFreq(unsigned int laurent, set<vertex_t> *laurentVertices, CoOccurrenceMatrix &coOccurrences);
+    void filterByCoOccurrences(unsigned int laurent, set<vertex_t> *laurentVertices, CoOccurrenceMatrix &coOccurrences);
   };
 }
 
@@ -25,75 +25,482 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 /******************************************* HBKGraph ********************************************/
 /*************************************************************************************************/
 
-bool HBKGraph::isNeighbour(set<vertex_t> vertices, vertex_t vertex)
+void HBKGraph::renumber(const vector<vertex_t> &numbers, map<id_t, id_t> &edgesMap)
 {
-  for (const vertex_t v : vertices)
+  Hypergraph *renumbered = new Hypergraph(createManagementInstance(Id::FIRST));
+  vector<vertex_t> renumberedLabels(numbers.size());
+  for (size_t i = 0; i < numbers.size(); i++)
   {
-    if (!(g->isNeighbor(v, vertex)))
+    renumbered->addVertex();
+    renumberedLabels[numbers[i] - 1] = original(i + 1);
+  }
+
+  map<id_t, id_t> renumberedMap;
+  for (const Hyperedge &e : g->hyperedges())
+  {
+    vector<vertex_t> elements;
+    elements.reserve(e.elements().size());
+    for (const vertex_t v : e.elements())
+      elements.push_back(numbers[v - 1]);
+    renumberedMap[renumbered->addEdge(std::move(elements))] = edgesMap[e.id()];
+  }
+
+  delete g;
+  g = renumbered;
+  labels.swap(renumberedLabels);
+  locals.resize(labels.size());
+  for (size_t i = 0; i < locals.size(); i++)
+    locals[i] = i + 1;
+  sort(locals.begin(), locals.end(), [this](vertex_t u, vertex_t v)
+       { return labels[u - 1] < labels[v - 1]; });
+  edgesMap.swap(renumberedMap);
+  indexed = false;
+}
+
+void HBKGraph::build()
+{
+  edgeIds.clear();
+  edgeOffsets.assign(1, 0);
+  edgeVertices.clear();
+  vertex_t maxVertex = g->vertexCount();
+  for (const Hyperedge &edge : g->hyperedges())
+  {
+    const vector<vertex_t> &elements = edge.sortedElements();
+    edgeIds.push_back(edge.id());
+    edgeVertices.insert(edgeVertices.end(), elements.begin(), elements.end());
+    edgeOffsets.push_back(edgeVertices.size());
+    if (!elements.empty() && elements.back() > maxVertex)
+      maxVertex = elements.back();
+  }
+
+  // The hyperedges of each vertex, by a counting sort of the incidences
+  vertexOffsets.assign(maxVertex + 2, 0);
+  for (vertex_t v : edgeVertices)
+    vertexOffsets[v + 1]++;
+  for (size_t v = 1; v < vertexOffsets.size(); v++)
+    vertexOffsets[v] += vertexOffsets[v - 1];
+  vertexEdges.resize(edgeVertices.size());
+  vector<size_t> next(vertexOffsets.begin(), vertexOffsets.end() - 1);
+  for (size_t e = 0; e < edgeIds.size(); e++)
+  {
+    for (size_t i = edgeOffsets[e]; i < edgeOffsets[e + 1]; i++)
+      vertexEdges[next[edgeVertices[i]]++] = e;
+  }
+
+  neighborOffsets.assign(maxVertex + 2, 0);
+  neighborVertices.clear();
+  vector<vertex_t> row;
+  for (vertex_t v = 0; v <= maxVertex; v++)
+  {
+    row.clear();
+    for (size_t i = vertexOffsets[v]; i < vertexOffsets[v + 1]; i++)
+    {
+      size_t e = vertexEdges[i];
+      for (size_t j = edgeOffsets[e]; j < edgeOffsets[e + 1]; j++)
+      {
+        if (edgeVertices[j] != v)
+          row.push_back(edgeVertices[j]);
+      }
+    }
+    sort(row.begin(), row.end());
+    neighborVertices.insert(neighborVertices.end(), row.begin(), unique(row.begin(), row.end()));
+    neighborOffsets[v + 1] = neighborVertices.size();
+  }
+
+  rowWords = (maxVertex + 64) / 64;
+  if ((maxVertex + 1) * rowWords * sizeof(uint64_t) <= Globals::adjacencyBudget)
+  {
+    adjacency.assign((maxVertex + 1) * rowWords, 0);
+    for (vertex_t v = 0; v <= maxVertex; v++)
+    {
+      for (size_t i = neighborOffsets[v]; i < neighborOffsets[v + 1]; i++)
+        adjacency[v * rowWords + neighborVertices[i] / 64] |= (uint64_t)1 << (neighborVertices[i] % 64);
+    }
+  }
+  else
+  {
+    rowWords = 0;
+    vector<uint64_t>().swap(adjacency);
+  }
+
+  tupleSize = edgeIds.empty() ? 0 : edgeOffsets[1];
+  for (size_t e = 1; e < edgeIds.size() && tupleSize; e++)
+  {
+    if (edgeOffsets[e + 1] - edgeOffsets[e] != tupleSize)
+      tupleSize = 0;
+  }
+  tuples.clear();
+  if (tupleSize)
+  {
+    tuples.reserve(edgeIds.size());
+    for (size_t e = 0; e < edgeIds.size(); e++)
+      tuples.emplace(Utils::hash(edgeVertices.data() + edgeOffsets[e], edgeVertices.data() + edgeOffsets[e + 1]), e);
+  }
+
+  links.clear();
+  linkTuples.clear();
+  linkOffsets.assign(1, 0);
+  linkVertices.clear();
+  if (tupleSize > 1)
+    buildLinks();
+
+  indexed = true;
+}
+
+void HBKGraph::buildLinks()
+{
+  // Each hyperedge gives one (subset, completing vertex) incidence per vertex
+  size_t size = tupleSize - 1;
+  vector<pair<size_t, unsigned int>> incidences;
+  incidences.reserve(edgeVertices.size());
+  for (size_t e = 0; e < edgeIds.size(); e++)
+  {
+    for (unsigned int i = 0; i < tupleSize; i++)
+      incidences.push_back(make_pair(e, i));
+  }
+
+  vector<vertex_t> a(size), b(size);
+  auto subset = [this](const pair<size_t, unsigned int> &incidence, vector<vertex_t> &tuple)
+  {
+    const vertex_t *elements = edgeVertices.data() + edgeOffsets[incidence.first];
+    copy(elements, elements + incidence.second, tuple.begin());
+    copy(elements + incidence.second + 1, elements + tupleSize, tuple.begin() + incidence.second);
+  };
+  auto completing = [this](const pair<size_t, unsigned int> &incidence)
+  {
+    return edgeVertices[edgeOffsets[incidence.first] + incidence.second];
+  };
+  sort(incidences.begin(), incidences.end(), [&](const pair<size_t, unsigned int> &x, const pair<size_t, unsigned int> &y)
+       {
+         subset(x, a);
+         subset(y, b);
+         return a != b ? a < b : completing(x) < completing(y);
+       });
+
+  for (size_t i = 0; i < incidences.size(); i++)
+  {
+    subset(incidences[i], a);
+    if (i == 0 || !equal(a.begin(), a.end(), linkTuples.end() - size))
+    {
+      if (i > 0)
+        linkOffsets.push_back(linkVertices.size());
+      links.emplace(Utils::hash(a.data(), a.data() + size), linkOffsets.size() - 1);
+      linkTuples.insert(linkTuples.end(), a.begin(), a.end());
+    }
+    linkVertices.push_back(completing(incidences[i]));
+  }
+  if (!incidences.empty())
+    linkOffsets.push_back(linkVertices.size());
+}
+
+/**
+ * Returns `true` if there are at most `limit` subsets of `k` elements among `n`.
+ */
+static bool fewSubsets(unsigned long n, unsigned long k, unsigned long limit)
+{
+  if (k > n)
+    return true;
+  k = k > n - k ? n - k : k;
+  unsigned long res = 1;
+  for (unsigned long j = 1; j <= k; j++)
+  {
+    res = res * (n - k + j) / j;
+    if (res > limit)
       return false;
   }
   return true;
 }
 
-set<id_t> HBKGraph::getEdges(vector<index_t> edgesId, vector<vertex_t> vertices)
+template <typename F>
+void HBKGraph::forEachSubset(SortedRange<vertex_t> pool, unsigned int size, bool with, vertex_t vertex, F f)
 {
-  set<id_t> result;
+  if (size > pool.size())
+    return;
 
-  FilteredHyperedgeCollection filteredHedges = g->hyperedgesAtPositions(edgesId);
-  filteredHedges.restrictTo(vertices);
+  // The indices and the tuple are kept on the stack unless the tuples are larger than the cliques usually are
+  unsigned int chosenBuffer[CLIQUE_CAPACITY];
+  vertex_t tupleBuffer[CLIQUE_CAPACITY + 1];
+  vector<unsigned int> chosenHeap;
+  vector<vertex_t> tupleHeap;
+  unsigned int *chosen = chosenBuffer;
+  vertex_t *tuple = tupleBuffer;
+  if (size > CLIQUE_CAPACITY)
+  {
+    chosenHeap.resize(size);
+    tupleHeap.resize(size + 1);
+    chosen = chosenHeap.data();
+    tuple = tupleHeap.data();
+  }
+  for (unsigned int i = 0; i < size; i++)
+    chosen[i] = i;
 
-  for (Hyperedge edge : filteredHedges)
-    result.insert(edge.id());
+  const vertex_t *elements = pool.begin();
+  while (true)
+  {
+    unsigned int j = 0;
+    for (unsigned int i = 0; i < size; i++)
+    {
+      if (with && j == i && vertex < elements[chosen[i]])
+        tuple[j++] = vertex;
+      tuple[j++] = elements[chosen[i]];
+    }
+    if (j < size + with)
+      tuple[j] = vertex;
 
-  return result;
+    f(SortedRange<vertex_t>(tuple, tuple + size + with));
+
+    // Next combination of `size` indices among pool.size()
+    int i = size - 1;
+    while (i >= 0 && chosen[i] == pool.size() - size + i)
+      i--;
+    if (i < 0)
+      return;
+    chosen[i]++;
+    for (unsigned int k = i + 1; k < size; k++)
+      chosen[k] = chosen[k - 1] + 1;
+  }
 }
 
-set<id_t> HBKGraph::getEdges(vector<vertex_t> vertices)
+template <typename F>
+void HBKGraph::forEachTuple(SortedRange<vertex_t> pool, unsigned int size, bool with, vertex_t vertex, F f)
 {
-  pair<vector<Hyperedge>, vector<index_t>> pair = Utils::toVectorsIdx(g->hyperedges());
-  return getEdges(pair.second, vertices);
+  forEachSubset(pool, size, with, vertex, [this, &f](SortedRange<vertex_t> tuple)
+                {
+                  auto range = tuples.equal_range(Utils::hash(tuple.begin(), tuple.end()));
+                  for (auto it = range.first; it != range.second; it++)
+                  {
+                    size_t e = it->second;
+                    if (equal(tuple.begin(), tuple.end(), edgeVertices.begin() + edgeOffsets[e]))
+                      f(e);
+                  }
+                });
 }
 
-set<id_t> HBKGraph::getEdges(set<vertex_t> vertices)
+template <typename F>
+void HBKGraph::forEachEdgeIn(const clique_t &vertices, F f)
 {
-  vector<vertex_t> vecVertices(vertices.begin(), vertices.end());
-  return getEdges(vecVertices);
+  index();
+
+  // Probe the subsets of `laurent` vertices when they are fewer than the incidences to scan
+  if (hashed())
+  {
+    size_t incidences = 0;
+    for (vertex_t u : vertices)
+    {
+      if (u + 1 < vertexOffsets.size())
+        incidences += vertexOffsets[u + 1] - vertexOffsets[u];
+    }
+    if (fewSubsets(vertices.size(), laurent, incidences))
+    {
+      forEachTuple(SortedRange<vertex_t>(vertices.begin(), vertices.end()), laurent, false, 0, f);
+      return;
+    }
+  }
+
+  for (vertex_t u : vertices)
+  {
+    if (u + 1 >= vertexOffsets.size())
+      break;
+
+    // Each edge is found from its smallest vertex
+    for (size_t i = vertexOffsets[u]; i < vertexOffsets[u + 1]; i++)
+    {
+      size_t e = vertexEdges[i];
+      if (edgeVertices[edgeOffsets[e]] != u)
+        continue;
+
+      size_t j = edgeOffsets[e] + 1;
+      while (j < edgeOffsets[e + 1] && vertices.count(edgeVertices[j]))
+        j++;
+      if (j == edgeOffsets[e + 1])
+        f(e);
+    }
+  }
 }
 
-set<id_t> HBKGraph::getEdges(vector<index_t> edgesId, set<vertex_t> vertices)
+template <typename F>
+void HBKGraph::forEachEdgeWith(const clique_t &vertices, vertex_t vertex, F f)
 {
-  vector<vertex_t> vecVertices(vertices.begin(), vertices.end());
-  return getEdges(edgesId, vecVertices);
+  index();
+  if (vertex + 1 >= vertexOffsets.size())
+    return;
+
+  if (hashed() && fewSubsets(vertices.size(), laurent - 1, vertexOffsets[vertex + 1] - vertexOffsets[vertex]))
+  {
+    clique_t pool(vertices);
+    pool.erase(vertex);
+    forEachTuple(SortedRange<vertex_t>(pool.begin(), pool.end()), laurent - 1, true, vertex, f);
+    return;
+  }
+
+  for (size_t i = vertexOffsets[vertex]; i < vertexOffsets[vertex + 1]; i++)
+  {
+    size_t e = vertexEdges[i];
+    size_t j = edgeOffsets[e];
+    while (j < edgeOffsets[e + 1] && (edgeVertices[j] == vertex || vertices.count(edgeVertices[j])))
+      j++;
+    if (j == edgeOffsets[e + 1])
+      f(e);
+  }
+}
+
+SortedRange<vertex_t> HBKGraph::link(SortedRange<vertex_t> subset)
+{
+  index();
+  size_t size = subset.size();
+  auto range = links.equal_range(Utils::hash(subset.begin(), subset.end()));
+  for (auto it = range.first; it != range.second; it++)
+  {
+    size_t l = it->second;
+    if (equal(subset.begin(), subset.end(), linkTuples.begin() + l * size))
+      return SortedRange<vertex_t>(linkVertices.data() + linkOffsets[l], linkVertices.data() + linkOffsets[l + 1]);
+  }
+  return SortedRange<vertex_t>(NULL, NULL);
 }
 
-set<id_t> HBKGraph::getEdges(vertex_t vertex)
+void HBKGraph::countLinks(const clique_t &vertices, vector<vertex_t> &linked)
 {
-  set<id_t> result;
-  for (Hyperedge edge : g->hyperedges(vertex))
+  linked.clear();
+  index();
+  forEachSubset(SortedRange<vertex_t>(vertices.begin(), vertices.end()), laurent - 1, false, 0, [this, &linked](SortedRange<vertex_t> subset)
+                {
+                  SortedRange<vertex_t> completing = link(subset);
+                  linked.insert(linked.end(), completing.begin(), completing.end());
+                });
+  sort(linked.begin(), linked.end());
+}
+
+void HBKGraph::completions(const clique_t &vertices, vertex_t vertex, vector<vertex_t> &result)
+{
+  bool first = true;
+  result.clear();
+  index();
+  forEachSubset(SortedRange<vertex_t>(vertices.begin(), vertices.end()), laurent - 2, true, vertex, [&](SortedRange<vertex_t> subset)
+                {
+                  if (!first && result.empty())
+                    return;
+                  SortedRange<vertex_t> completing = link(subset);
+                  if (first)
+                    result.assign(completing.begin(), completing.end());
+                  else
+                    Utils::intersect_with(result, completing);
+                  first = false;
+                });
+  result.erase(unique(result.begin(), result.end()), result.end());
+}
+
+bool HBKGraph::isNeighbour(const clique_t &vertices, vertex_t vertex)
+{
+  for (const vertex_t v : vertices)
   {
-    result.insert(edge.id());
+    if (!adjacent(v, vertex))
+      return false;
+  }
+  return true;
+}
+
+pool_set<id_t> HBKGraph::getEdges(const vector<index_t> &edgesId, const vector<vertex_t> &vertices)
+{
+  return getEdges(edgesId, clique_t(vertices.begin(), vertices.end()));
+}
+
+pool_set<id_t> HBKGraph::getEdges(const vector<vertex_t> &vertices)
+{
+  return getEdges(clique_t(vertices.begin(), vertices.end()));
+}
+
+pool_set<id_t> HBKGraph::getEdges(const clique_t &vertices)
+{
+  pool_set<id_t> result;
+  forEachEdgeIn(vertices, [this, &result](size_t e)
+                { result.insert(edgeIds[e]); });
+  return result;
+}
+
+pool_set<id_t> HBKGraph::getEdges(const vector<index_t> &edgesId, const clique_t &vertices)
+{
+  pool_set<id_t> result;
+  index();
+  for (index_t e : edgesId)
+  {
+    SortedRange<vertex_t> elements = edge(e);
+    if (includes(vertices.begin(), vertices.end(), elements.begin(), elements.end()))
+      result.insert(edgeIds[e]);
   }
   return result;
 }
 
-set<id_t> HBKGraph::getEdges(vector<index_t> edgesId, vertex_t vertex)
+pool_set<id_t> HBKGraph::getEdges(vertex_t vertex)
 {
-  set<id_t> result;
-  vector<index_t>::iterator it;
-  for (Hyperedge edge : g->hyperedges(vertex))
+  pool_set<id_t> result;
+  index();
+  if (vertex + 1 < vertexOffsets.size())
   {
-    if ((it = find(edgesId.begin(), edgesId.end(), edge.id())) != edgesId.end())
-      result.insert(edge.id());
+    for (size_t i = vertexOffsets[vertex]; i < vertexOffsets[vertex + 1]; i++)
+      result.insert(edgeIds[vertexEdges[i]]);
   }
   return result;
 }
 
-bool HBKGraph::isHyperClique(set<vertex_t> vertices)
+pool_set<id_t> HBKGraph::getEdges(const vector<index_t> &edgesId, vertex_t vertex)
 {
-  return (Utils::binom(vertices.size(), laurent) == getEdges(vertices).size());
+  pool_set<id_t> result;
+  for (id_t id : getEdges(vertex))
+  {
+    if (find(edgesId.begin(), edgesId.end(), id) != edgesId.end())
+      result.insert(id);
+  }
+  return result;
+}
+
+size_t HBKGraph::countEdges(const clique_t &vertices)
+{
+  size_t count = 0;
+  forEachEdgeIn(vertices, [&count](size_t)
+                { count++; });
+  return count;
+}
+
+size_t HBKGraph::countEdges(const clique_t &vertices, vertex_t vertex)
+{
+  size_t count = 0;
+  forEachEdgeWith(vertices, vertex, [&count](size_t)
+                  { count++; });
+  return count;
+}
+
+bool HBKGraph::isHyperClique(const clique_t &vertices)
+{
+  return (Utils::binom(vertices.size(), laurent) == countEdges(vertices));
+}
+
+void HBKGraph::completedBy(const clique_t &vertices, SortedRange<vertex_t> candidates, vertex_t vertex, vector<vertex_t> &result)
+{
+  result.clear();
+  if (laurent < 2 || countEdges(vertices, vertex) < Utils::binom(vertices.size(), laurent - 1))
+    return;
+
+  // `taken` is the given set and the candidates taken, `with` is the same plus `vertex`
+  clique_t taken(vertices);
+  clique_t with(vertices);
+  with.insert(vertex);
+  forEachNeighborIn(candidates, vertex, [&](vertex_t v)
+                    {
+                      // The hyperedges made of `v`, `vertex` and `laurent - 2` vertices taken
+                      size_t count = 0;
+                      forEachEdgeWith(with, v, [this, vertex, &count](size_t e)
+                                      {
+                                        if (binary_search(edgeVertices.begin() + edgeOffsets[e], edgeVertices.begin() + edgeOffsets[e + 1], vertex))
+                                          count++; });
+                      if (count >= Utils::binom(taken.size(), laurent - 2))
+                      {
+                        result.push_back(v);
+                        taken.insert(v);
+                        with.insert(v);
+                      } });
 }
 
-set<Hyperedge> HBKGraph::getEdgesSet(set<vertex_t> vertices)
+set<Hyperedge> HBKGraph::getEdgesSet(const clique_t &vertices)
 {
   set<Hyperedge> result;
   vector<vertex_t> vecVertices(vertices.begin(), vertices.end());
@@ -135,7 +542,7 @@ void simplify(set<Hyperedge> &edges)
     }
     for (jt = it, jt++; jt != edges.end(); jt++)
     {
-      vector<vertex_t> edgej = jt->sortedElements();
+      const vector<vertex_t> &edgej = jt->sortedElements();
       if (edgej.size() == 1)
       {
         set<Hyperedge>::iterator tmp = jt;
@@ -172,7 +579,7 @@ void simplify(set<Hyperedge> &edges)
   }
 }
 
-bool HBKGraph::isNonUniformClique(set<vertex_t> vertices)
+bool HBKGraph::isNonUniformClique(const clique_t &vertices)
 {
   if (Globals::verbose)
   {
@@ -22,18 +22,37 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #ifndef HBKGRAPH_H
 #define HBKGRAPH_H
 
+#include <unordered_map>
 #include "Utils.h"
+#include "NodePool.h"
 
+/**
+ * The hypergraph of one rank, enumerated by Bron & Kerbosch.
+ *
+ * The hyperedges are stored in `g` (used by the orderings and the node filters), and mirrored in a flat
+ * incidence structure for the queries of the enumeration: contiguous hyperedge to vertices and vertex
+ * to hyperedges arrays, and the sorted neighbours of each vertex. The flat structure is rebuilt on the
+ * first query following a change of the hyperedges, which must thus go through `addEdge` and `removeEdge`.
+ * When all the hyperedges have `laurent` vertices, they are also hashed by vertex tuple, so that the
+ * edges inside a small set can be found by probing its subsets rather than by scanning incidences.
+ * The neighbourhoods are also kept as rows of bits when they fit in `Globals::adjacencyBudget` bytes.
+ * The hashed hyperedges are finally linked from each of their subsets of `laurent - 1` vertices, so that
+ * the vertices completing a subset into a hyperedge are known without probing every candidate.
+ *
+ * The graph of a rank only has the vertices of that rank, numbered densely from 1 in increasing order,
+ * or in the order of the enumeration once `renumber`ed: `original` and `local` translate them from and
+ * to the vertices of the input.
+ */
 class HBKGraph
 {
 public:
   Hypergraph *g;
   unsigned int laurent;
 
-  HBKGraph() { g = new Hypergraph(createManagementInstance(Id::FIRST)); }
-  HBKGraph(unsigned int laurent) : laurent(laurent) { g = new Hypergraph(createManagementInstance(Id::FIRST)); }
+  HBKGraph() : indexed(false) { g = new Hypergraph(createManagementInstance(Id::FIRST)); }
+  HBKGraph(unsigned int laurent) : laurent(laurent), indexed(false) { g = new Hypergraph(createManagementInstance(Id::FIRST)); }
 
-  HBKGraph(unsigned int laurent, unsigned int nbVertices) : laurent(laurent)
+  HBKGraph(unsigned int laurent, unsigned int nbVertices) : laurent(laurent), indexed(false)
   {
     g = new Hypergraph(createManagementInstance(Id::FIRST));
     unsigned int i = 0;
@@ -44,48 +63,440 @@ public:
     }
   }
 
+  /**
+   * Creates the graph of the given (sorted) vertices of the input, numbered from 1 in the same order.
+   */
+  HBKGraph(unsigned int laurent, const set<vertex_t> &vertices) : laurent(laurent), labels(vertices.begin(), vertices.end()), indexed(false)
+  {
+    g = new Hypergraph(createManagementInstance(Id::FIRST));
+    for (size_t i = 0; i < labels.size(); i++)
+    {
+      g->addVertex();
+      locals.push_back(i + 1);
+    }
+  }
+
+  /**
+   * Creates the graph, without hyperedges, of the given (sorted) vertices of `other`, numbered from 1 in the
+   * same order: they stand for the same vertices of the input.
+   */
+  HBKGraph(const HBKGraph &other, const set<vertex_t> &vertices) : laurent(other.laurent), indexed(false)
+  {
+    g = new Hypergraph(createManagementInstance(Id::FIRST));
+    for (const vertex_t v : vertices)
+    {
+      g->addVertex();
+      labels.push_back(other.original(v));
+      locals.push_back(labels.size());
+    }
+    sort(locals.begin(), locals.end(), [this](vertex_t u, vertex_t v)
+         { return labels[u - 1] < labels[v - 1]; });
+  }
+
+  HBKGraph(const HBKGraph &) = delete;
+  HBKGraph &operator=(const HBKGraph &) = delete;
+
   ~HBKGraph() { delete g; }
 
+  /**
+   * Returns the vertex of the input numbered `vertex` in this graph.
+   */
+  vertex_t original(vertex_t vertex) const { return labels.empty() ? vertex : labels[vertex - 1]; }
+
+  clique_t original(const clique_t &vertices) const
+  {
+    if (labels.empty())
+      return vertices;
+    clique_t result;
+    for (const vertex_t v : vertices)
+      result.insert(labels[v - 1]);
+    return result;
+  }
+
+  /**
+   * Returns the sorted vertices of the input numbered `vertices` in this graph.
+   */
+  vector<vertex_t> original(SortedRange<vertex_t> vertices) const
+  {
+    vector<vertex_t> result(vertices.begin(), vertices.end());
+    if (!labels.empty())
+    {
+      for (vertex_t &v : result)
+        v = labels[v - 1];
+      sort(result.begin(), result.end());
+    }
+    return result;
+  }
+
+  /**
+   * Returns the number in this graph of the vertex `vertex` of the input, which must be one of its vertices.
+   */
+  vertex_t local(vertex_t vertex) const
+  {
+    if (labels.empty())
+      return vertex;
+    return *lower_bound(locals.begin(), locals.end(), vertex, [this](vertex_t local, vertex_t vertex)
+                        { return labels[local - 1] < vertex; });
+  }
+
+  clique_t local(const clique_t &vertices) const
+  {
+    if (labels.empty())
+      return vertices;
+    clique_t result;
+    for (const vertex_t v : vertices)
+      result.insert(local(v));
+    return result;
+  }
+
+  /**
+   * Numbers the vertex `v` as `numbers[v - 1]` (a permutation of 1..n), and the hyperedges from 1 in the order
+   * of their ids. `edgesMap` is keyed by the ids of the hyperedges, and is updated to their new ids.
+   */
+  void renumber(const vector<vertex_t> &numbers, map<id_t, id_t> &edgesMap);
+
+  /**
+   * Adds a hyperedge and returns its id.
+   */
+  id_t addEdge(vector<vertex_t> elements)
+  {
+    indexed = false;
+    return g->addEdge(std::move(elements));
+  }
+
+  /**
+   * Removes the hyperedge `id`.
+   */
+  void removeEdge(id_t id)
+  {
+    indexed = false;
+    g->removeEdge(id);
+  }
+
+  /**
+   * Returns the number of hyperedges.
+   */
+  size_t edgeCount()
+  {
+    index();
+    return edgeIds.size();
+  }
+
+  /**
+   * Returns the sorted vertices of the hyperedge at `position` (in the order of the ids).
+   */
+  SortedRange<vertex_t> edge(size_t position)
+  {
+    index();
+    return SortedRange<vertex_t>(edgeVertices.data() + edgeOffsets[position], edgeVertices.data() + edgeOffsets[position + 1]);
+  }
+
+  /**
+   * Returns the sorted neighbours of `vertex`.
+   */
+  SortedRange<vertex_t> neighbors(vertex_t vertex)
+  {
+    index();
+    if (vertex >= neighborOffsets.size() - 1)
+      return SortedRange<vertex_t>(NULL, NULL);
+    return SortedRange<vertex_t>(neighborVertices.data() + neighborOffsets[vertex], neighborVertices.data() + neighborOffsets[vertex + 1]);
+  }
+
+  /**
+   * Returns `true` if `u` and `v` are in a same edge.
+   */
+  bool adjacent(vertex_t u, vertex_t v)
+  {
+    index();
+    if (rowWords)
+      return u < neighborOffsets.size() - 1 && v < neighborOffsets.size() - 1 && ((adjacency[u * rowWords + v / 64] >> (v % 64)) & 1);
+    return neighbors(u).contains(v);
+  }
+
+  /**
+   * Sets `result` to the neighbours of `vertex` in the sorted `vertices`.
+   */
+  void neighborsIn(SortedRange<vertex_t> vertices, vertex_t vertex, vector<vertex_t> &result)
+  {
+    result.clear();
+    forEachNeighborIn(vertices, vertex, [&result](vertex_t v)
+                      { result.push_back(v); });
+  }
+
+  /**
+   * Keeps in the sorted `vertices` only the neighbours of `vertex`.
+   */
+  void retainNeighbors(vector<vertex_t> &vertices, vertex_t vertex)
+  {
+    vertices.erase(remove_if(vertices.begin(), vertices.end(), [this, vertex](vertex_t v)
+                             { return !adjacent(vertex, v); }),
+                   vertices.end());
+  }
+
+  /**
+   * Returns the number of neighbours of `vertex` in the sorted `vertices`.
+   */
+  size_t countNeighborsIn(SortedRange<vertex_t> vertices, vertex_t vertex)
+  {
+    size_t count = 0;
+    forEachNeighborIn(vertices, vertex, [&count](vertex_t)
+                      { count++; });
+    return count;
+  }
+
+  /**
+   * Returns the number of words of the rows of bits of the neighbourhoods, 0 if they are not kept.
+   */
+  size_t bitRowWords()
+  {
+    index();
+    return rowWords;
+  }
+
+  /**
+   * Sets `result` to the neighbours of `vertex` in the sorted `vertices`, which are the bits set in `bits` (at least
+   * `bitRowWords()` words). Over the words spanned by `vertices`, the row of `vertex` is ANDed with `bits` word by
+   * word, unless its neighbours or `vertices` are fewer than these words. Only if `bitRowWords()`.
+   */
+  void neighborsIn(SortedRange<vertex_t> vertices, const vector<uint64_t> &bits, vertex_t vertex, vector<vertex_t> &result)
+  {
+    result.clear();
+    index();
+    if (vertices.empty() || vertex >= neighborOffsets.size() - 1)
+      return;
+
+    SortedRange<vertex_t> row = neighbors(vertex);
+    const uint64_t *adjacent = adjacency.data() + vertex * rowWords;
+    size_t first = *vertices.begin() / 64, last = min((size_t)*(vertices.end() - 1) / 64 + 1, rowWords);
+    if (first >= last)
+      return;
+    if (row.size() < last - first && row.size() <= vertices.size())
+    {
+      for (const vertex_t v : row)
+      {
+        if ((bits[v / 64] >> (v % 64)) & 1)
+          result.push_back(v);
+      }
+    }
+    else if (vertices.size() < last - first)
+    {
+      for (const vertex_t v : vertices)
+      {
+        if (v / 64 < rowWords && ((adjacent[v / 64] >> (v % 64)) & 1))
+          result.push_back(v);
+      }
+    }
+    else
+    {
+      for (size_t w = first; w < last; w++)
+      {
+        for (uint64_t word = bits[w] & adjacent[w]; word; word &= word - 1)
+          result.push_back(w * 64 + __builtin_ctzll(word));
+      }
+    }
+  }
+
   /**
    * Returns `true` if `vertex` is in at least an edge with each vertex in `vertices`.
    */
-  bool isNeighbour(set<vertex_t> vertices, vertex_t vertex);
+  bool isNeighbour(const clique_t &vertices, vertex_t vertex);
 
   /**
    * Returns the set of edges in which `vertex` is a member.
    */
-  set<id_t> getEdges(vertex_t vertex);
+  pool_set<id_t> getEdges(vertex_t vertex);
 
   /**
    * Returns the set of edges present in the given set in which `vertex` is a member.
    */
-  set<id_t> getEdges(vector<index_t> edgesId, vertex_t vertex);
+  pool_set<id_t> getEdges(const vector<index_t> &edgesId, vertex_t vertex);
 
   /**
    * Returns the set of edges containing only the vertices in the given set.
    */
-  set<id_t> getEdges(set<vertex_t> vertices);
+  pool_set<id_t> getEdges(const clique_t &vertices);
 
   /**
    * Returns the set of edges which ids are in `edgesId` and containing only the vertices in the given set.
    */
-  set<id_t> getEdges(vector<index_t> edgesId, set<vertex_t> vertices);
+  pool_set<id_t> getEdges(const vector<index_t> &edgesId, const clique_t &vertices);
 
   /**
    * Returns the set of edges containing only the vertices in the given set.
    */
-  set<id_t> getEdges(vector<vertex_t> vertices);
+  pool_set<id_t> getEdges(const vector<vertex_t> &vertices);
 
   /**
    * Returns the set of edges which ids are in `edgesId` and containing only the vertices in the given set.
    */
-  set<id_t> getEdges(vector<index_t> edgesId, vector<vertex_t> vertices);
+  pool_set<id_t> getEdges(const vector<index_t> &edgesId, const vector<vertex_t> &vertices);
+
+  /**
+   * Returns the number of edges containing only the vertices in the given set.
+   */
+  size_t countEdges(const clique_t &vertices);
+
+  /**
+   * Returns the number of edges containing `vertex`, and otherwise only vertices in the given set.
+   */
+  size_t countEdges(const clique_t &vertices, vertex_t vertex);
+
+  bool isHyperClique(const clique_t &vertices);
+
+  /**
+   * Returns `true` if the hyperedges are linked from their subsets of `laurent - 1` vertices.
+   */
+  bool linked()
+  {
+    index();
+    return hashed() && laurent > 1;
+  }
+
+  /**
+   * Returns the sorted vertices completing the sorted `subset` of `laurent - 1` vertices into a hyperedge
+   * (once per hyperedge). Only if `linked()`.
+   */
+  SortedRange<vertex_t> link(SortedRange<vertex_t> subset);
+
+  /**
+   * Sets `linked` to the sorted vertices `v` completing subsets of `laurent - 1` vertices of the given set into
+   * hyperedges, each repeated as many times as there are such hyperedges. Only if `linked()`.
+   */
+  void countLinks(const clique_t &vertices, vector<vertex_t> &linked);
+
+  /**
+   * Sets `result` to the sorted vertices completing each subset of `laurent - 2` vertices of the given set, plus
+   * `vertex`, into a hyperedge. Only if `linked()`.
+   */
+  void completions(const clique_t &vertices, vertex_t vertex, vector<vertex_t> &result);
+
+  /**
+   * Sets `result` to candidates which `vertex` completes into hyperedges along with the given set: `vertex` makes
+   * a hyperedge with every subset of `laurent - 1` vertices of the set and of the candidates kept, so that any
+   * hyperclique among them extends with `vertex`. The candidates are taken greedily in increasing order, and none
+   * if `vertex` does not complete the subsets of the given set alone.
+   */
+  void completedBy(const clique_t &vertices, SortedRange<vertex_t> candidates, vertex_t vertex, vector<vertex_t> &result);
+
+  set<Hyperedge> getEdgesSet(const clique_t &vertices);
+
+  bool isNonUniformClique(const clique_t &vertices);
+
+private:
+  /* The vertices of the input, in the order of the vertices of this graph (empty if they are the same). */
+  vector<vertex_t> labels;
+  /* The vertices of this graph in the increasing order of their vertices of the input. */
+  vector<vertex_t> locals;
+
+  bool indexed;
+
+  /* The hyperedges in the order of their ids: the vertices of the i-th one are
+     edgeVertices[edgeOffsets[i]..edgeOffsets[i + 1]), sorted. */
+  vector<id_t> edgeIds;
+  vector<size_t> edgeOffsets;
+  vector<vertex_t> edgeVertices;
+
+  /* The positions of the hyperedges of each vertex, and its sorted neighbours, in the same form. */
+  vector<size_t> vertexOffsets;
+  vector<uint32_t> vertexEdges;
+  vector<size_t> neighborOffsets;
+  vector<vertex_t> neighborVertices;
+
+  /* The neighbourhood of each vertex as a row of `rowWords` words (0 if over the budget). */
+  size_t rowWords;
+  vector<uint64_t> adjacency;
+
+  /* The number of vertices of all the hyperedges (0 if they differ), and if any their positions by tuple hash. */
+  size_t tupleSize;
+  unordered_multimap<uint64_t, uint32_t> tuples;
+
+  /**
+   * Returns `true` if the hyperedges can be found by probing tuples of `laurent` vertices.
+   */
+  bool hashed() { return tupleSize && tupleSize == laurent; }
+
+  /* The links of the hashed hyperedges: the subset of the i-th one is linkTuples[i * (laurent - 1)..], and
+     its completing vertices linkVertices[linkOffsets[i]..linkOffsets[i + 1]), sorted. */
+  vector<vertex_t> linkTuples;
+  vector<size_t> linkOffsets;
+  vector<vertex_t> linkVertices;
+  unordered_multimap<uint64_t, uint32_t> links;
+
+  void buildLinks();
+
+  /**
+   * Rebuilds the flat incidence structure from `g` if the hyperedges changed.
+   */
+  void index()
+  {
+    if (!indexed)
+      build();
+  }
+
+  void build();
+
+  /**
+   * Calls `f` on each neighbour of `vertex` in the sorted `vertices`, in increasing order.
+   */
+  template <typename F>
+  void forEachNeighborIn(SortedRange<vertex_t> vertices, vertex_t vertex, F f)
+  {
+    index();
 
-  bool isHyperClique(set<vertex_t> vertices);
+    // The few neighbours of a vertex are looked up in `vertices` rather than the other way around
+    SortedRange<vertex_t> row = neighbors(vertex);
+    if (row.size() * 8 < vertices.size())
+    {
+      for (const vertex_t v : row)
+      {
+        if (vertices.contains(v))
+          f(v);
+      }
+    }
+    else if (rowWords)
+    {
+      if (vertex >= neighborOffsets.size() - 1)
+        return;
+      const uint64_t *bits = adjacency.data() + vertex * rowWords;
+      for (const vertex_t v : vertices)
+      {
+        if (v < neighborOffsets.size() - 1 && ((bits[v / 64] >> (v % 64)) & 1))
+          f(v);
+      }
+    }
+    else
+    {
+      for (const vertex_t v : vertices)
+      {
+        if (row.contains(v))
+          f(v);
+      }
+    }
+  }
 
-  set<Hyperedge> getEdgesSet(set<vertex_t> vertices);
+  /**
+   * Calls `f` on the position of each edge containing only the vertices in the given (sorted) set.
+   */
+  template <typename F>
+  void forEachEdgeIn(const clique_t &vertices, F f);
+
+  /**
+   * Calls `f` on the position of each edge containing `vertex`, and otherwise only vertices in the given set.
+   */
+  template <typename F>
+  void forEachEdgeWith(const clique_t &vertices, vertex_t vertex, F f);
 
-  bool isNonUniformClique(set<vertex_t> vertices);
+  /**
+   * Calls `f` on each sorted tuple made of `size` vertices of `pool` (sorted), plus `vertex` if `with`.
+   */
+  template <typename F>
+  static void forEachSubset(SortedRange<vertex_t> pool, unsigned int size, bool with, vertex_t vertex, F f);
+
+  /**
+   * Calls `f` on the position of each edge made of `size` vertices of `pool` (sorted), plus `vertex` if `with`.
+   */
+  template <typename F>
+  void forEachTuple(SortedRange<vertex_t> pool, unsigned int size, bool with, vertex_t vertex, F f);
 };
 
 #endif // HBKGRAPH_H
@@ -0,0 +1,171 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "JobPool.h"
+#include "Globals.h"
+#include "Utils.h"
+
+#include <iostream>
+#include <cstdlib>
+#include <cerrno>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/wait.h>
+
+void JobPool::run(const vector<string> &names, const function<void(size_t)> &job)
+{
+  vector<size_t> schedule(names.size());
+  for (size_t i = 0; i < names.size(); i++)
+    schedule[i] = i;
+  run(names, job, schedule);
+}
+
+void JobPool::run(const vector<string> &names, const function<void(size_t)> &job, const vector<size_t> &schedule)
+{
+  vector<Worker> jobs(names.size());
+  vector<bool> started(names.size(), false);
+  size_t next = 0, printed = 0, running = 0;
+  char buffer[1 << 16];
+
+  while (printed < names.size())
+  {
+    while (running < workers && next < schedule.size())
+    {
+      start(jobs[schedule[next]], names[schedule[next]], job, schedule[next]);
+      started[schedule[next]] = true;
+      next++;
+      running++;
+    }
+
+    vector<pollfd> fds;
+    vector<size_t> owners;
+    for (size_t i = 0; i < names.size(); i++)
+    {
+      if (started[i] && !jobs[i].done)
+      {
+        pollfd fd = {jobs[i].fd, POLLIN, 0};
+        fds.push_back(fd);
+        owners.push_back(i);
+      }
+    }
+
+    if (!fds.empty() && poll(fds.data(), fds.size(), -1) < 0 && errno != EINTR)
+    {
+      cout << "c | Cannot wait for the workers" << endl;
+      exit(-1);
+    }
+
+    for (size_t k = 0; k < fds.size(); k++)
+    {
+      if (fds[k].revents == 0)
+        continue;
+
+      Worker &worker = jobs[owners[k]];
+      ssize_t n = read(worker.fd, buffer, sizeof(buffer));
+      if (n > 0)
+        worker.output.append(buffer, n);
+      else if (n == 0 || errno != EINTR)
+      {
+        finish(worker, names[owners[k]]);
+        running--;
+        if (!ordered)
+        {
+          print(worker);
+          printed++;
+        }
+      }
+    }
+
+    // In the order of the list, the output of a worker waits for the ones of the previous jobs
+    while (ordered && printed < names.size() && started[printed] && jobs[printed].done)
+    {
+      print(jobs[printed]);
+      printed++;
+    }
+  }
+}
+
+void JobPool::start(Worker &worker, const string &name, const function<void(size_t)> &job, size_t index)
+{
+  int fds[2];
+  if (pipe(fds) == -1)
+  {
+    cout << "c | Cannot create a pipe for the worker of " << name << endl;
+    exit(-1);
+  }
+
+  // Nothing buffered by the parent may be written twice
+  cout.flush();
+  worker.pid = fork();
+  if (worker.pid == -1)
+  {
+    cout << "c | Cannot start the worker of " << name << endl;
+    exit(-1);
+  }
+
+  if (worker.pid == 0)
+  {
+    close(fds[0]);
+    dup2(fds[1], STDOUT_FILENO);
+    close(fds[1]);
+    job(index);
+    cout.flush();
+    _exit(0);
+  }
+
+  close(fds[1]);
+  worker.fd = fds[0];
+  worker.done = false;
+}
+
+void JobPool::finish(Worker &worker, const string &name)
+{
+  close(worker.fd);
+  worker.done = true;
+
+  int status;
+  while (waitpid(worker.pid, &status, 0) == -1 && errno == EINTR)
+    ;
+
+  if (WIFSIGNALED(status))
+  {
+    if (Globals::json)
+      worker.output += "{\"bench\": " + Utils::jsonString(name) + ", \"err\": \"workerKilled\"}\n";
+    else
+      worker.output += "c | * " + name + ": worker killed by signal " + to_string(WTERMSIG(status)) + "\n";
+  }
+  else if (WIFEXITED(status) && WEXITSTATUS(status) != 0)
+  {
+    if (Globals::json)
+      worker.output += "{\"bench\": " + Utils::jsonString(name) + ", \"err\": \"workerFailed\"}\n";
+    else
+      worker.output += "c | * " + name + ": worker exited with status " + to_string(WEXITSTATUS(status)) + "\n";
+  }
+}
+
+void JobPool::print(Worker &worker)
+{
+  if (output)
+    output(worker.output);
+  else
+    cout << worker.output << flush;
+  string().swap(worker.output);
+}
@@ -0,0 +1,74 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef JOB_POOL_H
+#define JOB_POOL_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <sys/types.h>
+using namespace std;
+
+/**
+ * Runs a list of jobs (typically one per file) with several worker processes.
+ * Each job is run in its own forked process: the graph, the enumeration state and the globals
+ * of a worker are private, exactly as if the program had been run on that job alone.
+ * The standard output of a worker is collected and printed as a whole, either as soon as the worker
+ * is done (completion order) or in the order of the list.
+ */
+class JobPool
+{
+public:
+  /**
+   * The output of each worker is given to `output`, or printed if there is none.
+   */
+  JobPool(unsigned int workers, bool ordered, const function<void(const string &)> &output = NULL)
+      : workers(workers), ordered(ordered), output(output) {}
+
+  /**
+   * Calls `job` on every index of `names` and waits for all of them.
+   * The jobs are started in the order of `schedule` (a permutation of the indices), or in the order
+   * of `names` without it; the ordered output always follows the order of `names`.
+   * `names` identify the jobs in the error messages.
+   */
+  void run(const vector<string> &names, const function<void(size_t)> &job);
+  void run(const vector<string> &names, const function<void(size_t)> &job, const vector<size_t> &schedule);
+
+private:
+  struct Worker
+  {
+    pid_t pid;
+    int fd;
+    bool done;
+    string output;
+  };
+
+  unsigned int workers;
+  bool ordered;
+  function<void(const string &)> output;
+
+  void start(Worker &worker, const string &name, const function<void(size_t)> &job, size_t index);
+  void finish(Worker &worker, const string &name);
+  void print(Worker &worker);
+};
+
+#endif // JOB_POOL_H
@@ -34,11 +34,47 @@ bool Globals::maxClique = false;
 unsigned int Globals::filteringValue = NO_FILTER;
 unsigned int Globals::orderingValue = RANDOM_ORDERING;
 unsigned int Globals::nodeFilteringValue = NO_FILTER;
+unsigned int Globals::pivotValue = NO_PIVOT;
+unsigned int Globals::parsingThreads = 1;
+size_t Globals::adjacencyBudget = ADJACENCY_BUDGET;
 double Globals::timer = 0;
 bool Globals::timedout = false;
 string Globals::jsonLine = "";
 
 bool hbk, ce, ce_hbk, nu_hbk;
+string saveBin;
+unsigned int jobs = 1;
+bool orderedJobs = false;
+string jobFile;
+string databaseFile;
+string cacheDirectory;
+
+/**
+ * A configuration of the run-matrix mode (see --matrix).
+ */
+struct Configuration
+{
+  unsigned int orderingValue;
+  unsigned int filteringValue;
+  unsigned int nodeFilteringValue;
+  unsigned int pivotValue;
+};
+
+bool matrixMode = false;
+vector<Configuration> matrix;
+string orderings = "", filterings = "", nodeFilterings = "", pivots = "";
+
+/* The database of --sqlite, owned by the main process (the workers print their runs to it). */
+RunsDatabase *database = NULL;
+pid_t databaseOwner;
+
+/* The result cache of --cache, and the hash of the file being processed (empty if it is not cached). */
+ResultCache *cache = NULL;
+string instanceHash;
+
+/* The file being processed, and the length of the header of its json line. */
+string currentFile;
+size_t jsonHeaderSize = 0;
 
 void printHelp()
 {
@@ -71,6 +107,10 @@ void printHelp()
   cout << "    <i>=2             clique filter." << endl;
   cout << "    <i>=3             neighbourhood filter." << endl;
   cout << "    <i>=4             Incremental 'filter'." << endl;
+  cout << "  -P<i>     uses a pivot to branch on fewer candidates (-a, -b, -c)." << endl;
+  cout << "    <i>=0   [default] no pivot." << endl;
+  cout << "    <i>=1             Tomita: the pivot making the most candidates redundant." << endl;
+  cout << "    <i>=2             the pivot of greatest degree." << endl;
   cout << "  -o<i>     uses ordering on candidates set." << endl;
   cout << "    <i>=0   [default] random." << endl;
   cout << "    <i>=1             min-degree." << endl;
@@ -78,8 +118,29 @@ void printHelp()
   cout << "    <i>=3             natural." << endl;
   cout << "    <i>=4             degeneracy-graph." << endl;
   cout << "    <i>=5             max-degree." << endl;
-  cout << "  -i <n>    specifies the input file." << endl;
+  cout << "  -i <n>    specifies the input file (memory-mapped and decoded in place)." << endl;
   cout << "            If the `n` is a directory then the program is run for every file in `n`." << endl;
+  cout << "            If the `n` is a binary snapshot (see --save-bin) then it is loaded without parsing." << endl;
+  cout << "            A DIMACS CNF file (`p cnf` line) is read as the hypergraph of its clauses (see -m)." << endl;
+  cout << "            A gzip, bzip2 or zstd compressed file is decompressed while it is parsed." << endl;
+  cout << "            If the `n` is a tar archive (.tar, .tgz, .tbz, .tzst, ...) then the program is run" << endl;
+  cout << "            for every file in `n`, read directly from the archive." << endl;
+  cout << "  -T<i>     parses the input with `i` threads (default 1)." << endl;
+  cout << "  --adjacency <i> keeps the neighbourhoods of a rank as rows of bits when they fit in `i` MiB" << endl;
+  cout << "            (default " << (ADJACENCY_BUDGET >> 20) << ", 0 disables them)." << endl;
+  cout << "  --save-bin <n>  writes the parsed hypergraph as a binary snapshot in the file `n`." << endl;
+  cout << "  -J <i>    processes the files of a directory with `i` worker processes (default 1)." << endl;
+  cout << "            The output of each file is printed as soon as it is done." << endl;
+  cout << "  --ordered with -J, prints the output of the files in the order of the directory (or job file)." << endl;
+  cout << "  --sqlite <n> writes the runs in the `runs` table of the sqlite database `n` instead of" << endl;
+  cout << "            printing their json lines (see the README for the schema)." << endl;
+  cout << "  --cache <n> keeps the output of each run in the directory `n`: a run of the same instance" << endl;
+  cout << "            (same bytes) with the same options and the same binary is read back instead of enumerated." << endl;
+  cout << "  --matrix  parses each input once and runs every combination of the -o, -f, -n and -P values," << endl;
+  cout << "            given as lists (e.g. -o0,3,5 -f0-4 -n0,1 -P0-2), with `i` workers if -J <i> is given." << endl;
+  cout << "  --jobs <n> runs the jobs of the file `n` instead of -i, one per line: the path of an instance" << endl;
+  cout << "            followed by its own -a/-b/-c/-u, -o<i>, -f<i>, -n<i>, -P<i> and -t <s> (default: the command line)." << endl;
+  cout << "            With -J, the jobs predicted to be the longest are started first." << endl;
 
   cout << "and input is specified as follows" << endl;
   cout << "  INPUT       input file in PACE 2019 format" << endl
@@ -113,26 +174,20 @@ void printTime(double time)
     cout << ", \"totaltime\": " << time << "}" << endl;
 }
 
-SweetHBK::Graph *parse(streambuf *std_in, streambuf *file_buf, double *parsingTime)
+void parsed(SweetHBK::Graph *graph, double parsingTime)
 {
-  // Redirect standard input
-  cin.rdbuf(file_buf);
-  chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
-  SweetHBK::Graph *graph = new SweetHBK::Graph();
-  chrono::high_resolution_clock::time_point end = chrono::high_resolution_clock::now();
-  *parsingTime = ((end - start).count() / 1e9);
   if (!Globals::json && !Globals::statsh)
   {
-    int l10 = ceil(log10(*parsingTime));
+    int l10 = ceil(log10(parsingTime));
     l10 = l10 <= 0 ? 1 : l10;
-    cout << "c | parsing time: " << setprecision(9) << *parsingTime << " seconds" << setw(LENGTH - 33 - l10) << "|" << endl;
+    cout << "c | parsing time: " << setprecision(9) << parsingTime << " seconds" << setw(LENGTH - 33 - l10) << "|" << endl;
   }
   if (Globals::json)
-    Globals::jsonLine += ", \"parsingtime\": " + to_string(*parsingTime);
+    Globals::jsonLine += ", \"parsingtime\": " + to_string(parsingTime);
 
   if (Globals::verbose && !Globals::statsh)
   {
-    cout << "c | ... parsing done ..." << setw(LENGTH - 21) << "|" << endl;
+    cout << "c | ... parsing done ..." << setw(LENGTH - 21) << "|" << endl;
     cout << graph->edges.size() << endl;
     for (auto e : graph->edges)
     {
@@ -160,15 +215,247 @@ SweetHBK::Graph *parse(streambuf *std_in, streambuf *file_buf, double *parsingTi
       cout << endl;
     }
   }
+}
+
+SweetHBK::Graph *parse(streambuf *std_in, streambuf *file_buf, double *parsingTime)
+{
+  // Redirect standard input
+  cin.rdbuf(file_buf);
+  chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+  SweetHBK::Graph *graph;
+  if (Globals::parsingThreads > 1)
+  {
+    // The input is read at once so that it can be split between the parsing threads
+    string input((istreambuf_iterator<char>(cin)), istreambuf_iterator<char>());
+    graph = new SweetHBK::Graph(input.data(), input.data() + input.size());
+  }
+  else
+    graph = new SweetHBK::Graph();
+  chrono::high_resolution_clock::time_point end = chrono::high_resolution_clock::now();
+  cin.rdbuf(std_in);
+  *parsingTime = ((end - start).count() / 1e9);
+  parsed(graph, *parsingTime);
   return graph;
 }
 
-void doIt(streambuf *std_in, streambuf *file_buf)
+SweetHBK::Graph *parse(const MappedFile &file, double *parsingTime)
 {
-  double processTime, totalTime, parsingTime;
-  SweetHBK::Graph *graph = parse(std_in, file_buf, &parsingTime);
+  chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+  SweetHBK::Graph *graph = new SweetHBK::Graph(file.begin(), file.end());
+  chrono::high_resolution_clock::time_point end = chrono::high_resolution_clock::now();
+  *parsingTime = ((end - start).count() / 1e9);
+  parsed(graph, *parsingTime);
+  return graph;
+}
+
+SweetHBK::Graph *parse(streambuf &input, double *parsingTime)
+{
+  chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+  SweetHBK::Graph *graph;
+  if (Globals::parsingThreads > 1)
+  {
+    // The input is decompressed at once so that it can be split between the parsing threads
+    string text((istreambuf_iterator<char>(&input)), istreambuf_iterator<char>());
+    graph = new SweetHBK::Graph(text.data(), text.data() + text.size());
+  }
+  else
+    graph = new SweetHBK::Graph(&input);
+  chrono::high_resolution_clock::time_point end = chrono::high_resolution_clock::now();
+  *parsingTime = ((end - start).count() / 1e9);
+  parsed(graph, *parsingTime);
+  return graph;
+}
+
+/**
+ * Parses a decompressed stream, holding back what the parse prints until the stream is known to be whole:
+ * returns NULL, with nothing printed, if `corrupted` tells that the stream was cut short.
+ */
+SweetHBK::Graph *parse(streambuf &input, double *parsingTime, const function<bool()> &corrupted)
+{
+  string jsonLine = Globals::jsonLine;
+  ostringstream output;
+  streambuf *out = cout.rdbuf(output.rdbuf());
+  SweetHBK::Graph *graph = parse(input, parsingTime);
+  cout.rdbuf(out);
+  if (corrupted())
+  {
+    delete graph;
+    Globals::jsonLine = jsonLine;
+    return NULL;
+  }
+  cout << output.str();
+  return graph;
+}
+
+SweetHBK::Graph *parse(const Snapshot &snapshot, double *parsingTime)
+{
+  chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+  SweetHBK::Graph *graph = new SweetHBK::Graph(snapshot);
+  chrono::high_resolution_clock::time_point end = chrono::high_resolution_clock::now();
+  *parsingTime = ((end - start).count() / 1e9);
+  parsed(graph, *parsingTime);
+  return graph;
+}
+
+/**
+ * Returns the beginning of the json line of `fileName` with the current options.
+ */
+string jsonHeader(const string &fileName)
+{
+  if (Globals::statsh)
+    return "{\"bench\": " + Utils::jsonString(fileName);
 
-  double timeLeft = Globals::timer - parsingTime;
+  string header = "{\"bench\": " + Utils::jsonString(fileName) + ", \"o\": " + to_string(Globals::orderingValue) + ", \"f\": " + to_string(Globals::filteringValue) + ", \"n\": " + to_string(Globals::nodeFilteringValue);
+  if (Globals::pivotValue)
+    header += ", \"pivot\": " + to_string(Globals::pivotValue);
+  if (Globals::timer)
+    header += ", \"Timeout\": " + to_string(Globals::timer);
+  return header;
+}
+
+/**
+ * Prints the name of the file to process, or starts its json line.
+ */
+void startFile(const string &fileName)
+{
+  int inst = 50;
+  int remain = LENGTH - inst - 3;
+  currentFile = fileName;
+  if (!Globals::statsh && !Globals::json)
+    cout << "c | * " << setw(inst) << fileName << setw(remain) << "|" << endl;
+  else if (Globals::json)
+    Globals::jsonLine = jsonHeader(fileName);
+  else
+    cout << fileName << ",";
+  jsonHeaderSize = Globals::jsonLine.size();
+}
+
+void fileError(const string &message, const string &error)
+{
+  int inst = 50;
+  int remain = LENGTH - inst - 3;
+  if (!Globals::statsh && !Globals::json)
+    cout << "c | * " << setw(inst) << message << setw(remain) << "|" << endl;
+  else if (Globals::statsh && !Globals::json)
+    cout << message << endl;
+  else
+    cout << Globals::jsonLine << ", \"err\": \"" << error << "\"}" << endl;
+}
+
+/**
+ * Prints the output of one or several runs; with --sqlite, the runs go to the database instead.
+ * In a worker process, the runs are printed for the main process to write them.
+ */
+void emit(const string &output)
+{
+  if (database == NULL || getpid() != databaseOwner)
+  {
+    cout << output << flush;
+    return;
+  }
+
+  istringstream lines(output);
+  for (string line; getline(lines, line);)
+  {
+    if (!RunsDatabase::isRun(line) || !database->add(line))
+      cout << line << endl;
+  }
+}
+
+void enumerateMethods(SweetHBK::Graph *graph, double parsingTime);
+
+/**
+ * Returns the key of the current run in the result cache: the hash of the instance
+ * and every option that changes the output.
+ */
+string runKey()
+{
+  return instanceHash + " " + (hbk ? "a" : "") + (ce ? "b" : "") + (ce_hbk ? "c" : "") + (nu_hbk ? "u" : "") +
+         " o" + to_string(Globals::orderingValue) + " f" + to_string(Globals::filteringValue) +
+         " n" + to_string(Globals::nodeFilteringValue) + " P" + to_string(Globals::pivotValue) + " t" + to_string(Globals::timer) +
+         (Globals::maxClique ? " x" : "") + (Globals::cardinality ? " m" : "") +
+         (Globals::print ? "" : " p") + (Globals::debug ? " d" : "") + (Globals::printedge ? " l" : "") +
+         (Globals::verbose ? " v" : "") + (Globals::json ? " j" : "") +
+         (Globals::statsc ? " sc" : "") + (Globals::statsh ? " sh" : "");
+}
+
+/**
+ * Returns `true` if one of the runs of `output` timed out: such a result is not cached.
+ */
+bool timedOut(const string &output)
+{
+  if (output.find("\"timedout\": 1") != string::npos)
+    return true;
+  size_t p = output.find("c | timedout:");
+  while (p != string::npos)
+  {
+    if (atoi(output.c_str() + p + 13) != 0)
+      return true;
+    p = output.find("c | timedout:", p + 1);
+  }
+  return false;
+}
+
+void enumerate(SweetHBK::Graph *graph, double parsingTime)
+{
+  string key = (cache != NULL && !instanceHash.empty()) ? runKey() : "";
+  string cachedLine, cached;
+  if (!key.empty() && cache->find(key, cachedLine, cached))
+  {
+    // The cached lines start with the json line of the file that was run: it is replaced by the current one
+    string output;
+    istringstream lines(cached);
+    for (string line; getline(lines, line);)
+    {
+      if (Globals::json && !cachedLine.empty() && line.compare(0, cachedLine.size(), cachedLine) == 0)
+        line = Globals::jsonLine + line.substr(cachedLine.size());
+      output += line + "\n";
+    }
+    emit(output);
+    return;
+  }
+
+  if (database == NULL && key.empty())
+  {
+    enumerateMethods(graph, parsingTime);
+    return;
+  }
+
+  ostringstream output;
+  streambuf *out = cout.rdbuf(output.rdbuf());
+  enumerateMethods(graph, parsingTime);
+  cout.rdbuf(out);
+  if (!key.empty() && !timedOut(output.str()))
+    cache->store(key, Globals::json ? Globals::jsonLine : "", output.str());
+  emit(output.str());
+}
+
+/**
+ * Builds the graphs of the ranks for the current ordering and node filter, and prints the time it took.
+ */
+double buildRanks(SweetHBK::Graph *graph)
+{
+  chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+  graph->createRankGraphs();
+  chrono::high_resolution_clock::time_point end = chrono::high_resolution_clock::now();
+  double rankTime = ((end - start).count() / 1e9);
+
+  if (!Globals::json && !Globals::statsh)
+  {
+    int l10 = ceil(log10(rankTime));
+    l10 = l10 <= 0 ? 1 : l10;
+    cout << "c | rank graphs time: " << setprecision(9) << rankTime << " seconds" << setw(LENGTH - 37 - l10) << "|" << endl;
+  }
+  if (Globals::json)
+    Globals::jsonLine += ", \"ranktime\": " + to_string(rankTime);
+  return rankTime;
+}
+
+void enumerateMethods(SweetHBK::Graph *graph, double parsingTime)
+{
+  double processTime, totalTime;
+  double rankTime = (hbk || ce || ce_hbk) ? buildRanks(graph) : 0;
+  double timeLeft = Globals::timer - parsingTime - rankTime;
 
   if (hbk)
   {
@@ -190,7 +477,7 @@ void doIt(streambuf *std_in, streambuf *file_buf)
       processTime = graph->enumerateHyperCliques(&SweetHBK::Graph::getHyperClique);
     BronKerbosch::cleanBiggest();
 
-    totalTime = parsingTime + processTime;
+    totalTime = parsingTime + rankTime + processTime;
     printTime(totalTime);
   }
 
@@ -214,7 +501,7 @@ void doIt(streambuf *std_in, streambuf *file_buf)
       processTime = graph->enumerateHyperCliques(&SweetHBK::Graph::getHyperCliqueCE);
     BronKerbosch::cleanBiggest();
 
-    totalTime = parsingTime + processTime;
+    totalTime = parsingTime + rankTime + processTime;
     printTime(totalTime);
   }
 
@@ -237,7 +524,7 @@ void doIt(streambuf *std_in, streambuf *file_buf)
     else
       processTime = graph->enumerateHyperCliques(&SweetHBK::Graph::getHyperCliqueCE_HBK);
 
-    totalTime = parsingTime + processTime;
+    totalTime = parsingTime + rankTime + processTime;
     printTime(totalTime);
   }
 
@@ -253,8 +540,244 @@ void doIt(streambuf *std_in, streambuf *file_buf)
 
   if (!Globals::statsh && !Globals::json)
     cout << DLINE << endl;
+}
 
-  cin.rdbuf(std_in);
+/**
+ * Runs every configuration of the matrix on the parsed graph.
+ * Each configuration runs in its own worker process on a copy-on-write image of the graph,
+ * so that the parse is shared and the enumerations do not see each other.
+ */
+void doMatrix(SweetHBK::Graph *graph, double parsingTime)
+{
+  string parsing = Globals::jsonLine.substr(jsonHeaderSize);
+  bool header = (jsonHeaderSize > 0);
+
+  vector<string> names;
+  for (const Configuration &configuration : matrix)
+    names.push_back(currentFile + " -o" + to_string(configuration.orderingValue) + " -f" + to_string(configuration.filteringValue) + " -n" + to_string(configuration.nodeFilteringValue) + " -P" + to_string(configuration.pivotValue));
+
+  JobPool(jobs, orderedJobs, emit).run(names, [&](size_t i)
+                                 {
+    Globals::orderingValue = matrix[i].orderingValue;
+    Globals::filteringValue = matrix[i].filteringValue;
+    Globals::nodeFilteringValue = matrix[i].nodeFilteringValue;
+    Globals::pivotValue = matrix[i].pivotValue;
+    if (Globals::json)
+      Globals::jsonLine = (header ? jsonHeader(currentFile) : "") + parsing;
+    else if (!Globals::statsh)
+    {
+      Utils::printFiltering();
+      Utils::printOrdering();
+      Utils::printNodeFiltering();
+      Utils::printPivot();
+    }
+    enumerate(graph, parsingTime); });
+}
+
+void doIt(SweetHBK::Graph *graph, double parsingTime)
+{
+  if (!saveBin.empty() && !Snapshot::save(*graph, saveBin))
+  {
+    cout << "c | Cannot write the binary snapshot " << saveBin << endl;
+    exit(-1);
+  }
+
+  if (matrixMode)
+    doMatrix(graph, parsingTime);
+  else
+    enumerate(graph, parsingTime);
+}
+
+void doIt(streambuf *std_in, streambuf *file_buf)
+{
+  double parsingTime;
+  SweetHBK::Graph *graph = parse(std_in, file_buf, &parsingTime);
+  doIt(graph, parsingTime);
+}
+
+void doIt(const string &fileName)
+{
+  MappedFile file;
+  instanceHash.clear();
+  if (!file.open(fileName))
+  {
+    fileError("FILE NOT FOUND", "fileNotFound");
+    return;
+  }
+  if (cache != NULL)
+    instanceHash = ResultCache::hash(file.begin(), file.end());
+
+  double parsingTime;
+  SweetHBK::Graph *graph;
+  compressionType compression = Decompressor::compression(file.begin(), file.end());
+  if (compression != uncompressed)
+  {
+    Decompressor input(file.begin(), file.end(), compression);
+    if (!input.valid)
+    {
+      fileError("CANNOT DECOMPRESS", "cannotDecompress");
+      return;
+    }
+    graph = parse(input, &parsingTime, [&input]
+                  { return input.corrupted; });
+    if (graph == NULL)
+    {
+      fileError("CORRUPTED COMPRESSED FILE", "corruptedFile");
+      return;
+    }
+  }
+  else if (Snapshot::isSnapshot(file.begin(), file.end()))
+  {
+    Snapshot snapshot(file.begin(), file.end());
+    if (!snapshot.valid)
+    {
+      fileError("INVALID SNAPSHOT", "invalidSnapshot");
+      return;
+    }
+    graph = parse(snapshot, &parsingTime);
+  }
+  else
+    graph = parse(file, &parsingTime);
+  file.close();
+  doIt(graph, parsingTime);
+}
+
+/**
+ * Runs the program on one file of a directory.
+ */
+void doFile(const string &fileName)
+{
+  startFile(fileName);
+  doIt(fileName);
+}
+
+/**
+ * Runs the jobs of a job file, with their own methods and options.
+ * With several workers, the jobs are started from the longest predicted to the shortest,
+ * so that a long instance does not hold up the end of the batch.
+ */
+void doJobs(const string &jobFile)
+{
+  BatchJob defaults;
+  defaults.hbk = hbk;
+  defaults.ce = ce;
+  defaults.ce_hbk = ce_hbk;
+  defaults.nu_hbk = nu_hbk;
+  defaults.orderingValue = Globals::orderingValue;
+  defaults.filteringValue = Globals::filteringValue;
+  defaults.nodeFilteringValue = Globals::nodeFilteringValue;
+  defaults.pivotValue = Globals::pivotValue;
+  defaults.timer = Globals::timer;
+
+  vector<BatchJob> batch;
+  string error;
+  if (!BatchJob::read(jobFile, defaults, batch, error))
+  {
+    cout << "Option --jobs: " << error << "." << endl;
+    exit(-1);
+  }
+
+  function<void(size_t)> job = [&batch](size_t i)
+  {
+    hbk = batch[i].hbk;
+    ce = batch[i].ce;
+    ce_hbk = batch[i].ce_hbk;
+    nu_hbk = batch[i].nu_hbk;
+    Globals::orderingValue = batch[i].orderingValue;
+    Globals::filteringValue = batch[i].filteringValue;
+    Globals::nodeFilteringValue = batch[i].nodeFilteringValue;
+    Globals::pivotValue = batch[i].pivotValue;
+    Globals::timer = batch[i].timer;
+    doFile(batch[i].file);
+  };
+
+  if (jobs == 1)
+  {
+    for (size_t i = 0; i < batch.size(); i++)
+      job(i);
+    return;
+  }
+
+  vector<string> names;
+  vector<size_t> schedule;
+  for (size_t i = 0; i < batch.size(); i++)
+  {
+    batch[i].predictCost();
+    names.push_back(batch[i].file);
+    schedule.push_back(i);
+  }
+  stable_sort(schedule.begin(), schedule.end(), [&batch](size_t i, size_t j)
+              { return batch[i].cost > batch[j].cost; });
+  JobPool(jobs, orderedJobs, emit).run(names, job, schedule);
+}
+
+/**
+ * Runs the program on every regular file of a (possibly compressed) tar archive,
+ * reading the members one after the other from the archive stream.
+ */
+void doArchive(const string &fileName)
+{
+  MappedFile file;
+  if (!file.open(fileName))
+  {
+    startFile(fileName);
+    fileError("FILE NOT FOUND", "fileNotFound");
+    return;
+  }
+
+  Decompressor input(file.begin(), file.end(), Decompressor::compression(file.begin(), file.end()));
+  if (!input.valid)
+  {
+    startFile(fileName);
+    fileError("CANNOT DECOMPRESS", "cannotDecompress");
+    return;
+  }
+
+  TarReader archive(&input);
+  while (archive.next())
+  {
+    string baseName = archive.name.substr(archive.name.find_last_of('/') + 1);
+    if (baseName.empty() || baseName[0] == '.')
+      continue;
+    startFile(archive.name);
+    double parsingTime;
+    SweetHBK::Graph *graph = parse(*archive.member(), &parsingTime, [&archive, &input]
+                                   { return archive.corrupted || input.corrupted; });
+    if (graph == NULL)
+    {
+      fileError("CORRUPTED ARCHIVE", "corruptedArchive");
+      return;
+    }
+    doIt(graph, parsingTime);
+  }
+
+  if (archive.corrupted || input.corrupted)
+  {
+    startFile(fileName);
+    fileError("CORRUPTED ARCHIVE", "corruptedArchive");
+  }
+}
+
+/**
+ * Reads a list of option values such as "0,3,5" or "0-4".
+ * Returns `value` alone if the list is empty.
+ */
+vector<unsigned int> readValues(const string &list, unsigned int value)
+{
+  vector<unsigned int> values;
+  stringstream ss(list);
+  string item;
+  while (getline(ss, item, ','))
+  {
+    size_t dash = item.find('-');
+    unsigned int first = atoi(item.c_str());
+    unsigned int last = (dash == string::npos) ? first : atoi(item.c_str() + dash + 1);
+    for (unsigned int v = first; v <= last; v++)
+      values.push_back(v);
+  }
+  if (values.empty())
+    values.push_back(value);
+  return values;
 }
 
 /**
@@ -272,8 +795,6 @@ int main(int argc, char **argv)
   nu_hbk = false;
 
   streambuf *std_in = cin.rdbuf();
-  streambuf *file_buf = std_in;
-  fstream file;
   int filei = 0;
 
   for (int i = 1; i < argc; i++)
@@ -282,6 +803,82 @@ int main(int argc, char **argv)
     {
       switch (argv[i][1])
       {
+      case '-':
+        if (string(argv[i]) == "--save-bin")
+        {
+          if (++i < argc)
+          {
+            saveBin = argv[i];
+          }
+          else
+          {
+            cout << "Option --save-bin must be followed by a file name." << endl;
+            exit(-1);
+          }
+        }
+        else if (string(argv[i]) == "--jobs")
+        {
+          if (++i < argc)
+          {
+            jobFile = argv[i];
+          }
+          else
+          {
+            cout << "Option --jobs must be followed by a file name." << endl;
+            exit(-1);
+          }
+        }
+        else if (string(argv[i]) == "--sqlite")
+        {
+          if (++i < argc)
+          {
+            databaseFile = argv[i];
+            Globals::json = true;
+          }
+          else
+          {
+            cout << "Option --sqlite must be followed by a file name." << endl;
+            exit(-1);
+          }
+        }
+        else if (string(argv[i]) == "--cache")
+        {
+          if (++i < argc)
+          {
+            cacheDirectory = argv[i];
+          }
+          else
+          {
+            cout << "Option --cache must be followed by a directory name." << endl;
+            exit(-1);
+          }
+        }
+        else if (string(argv[i]) == "--adjacency")
+        {
+          if (++i < argc && atoi(argv[i]) >= 0)
+          {
+            Globals::adjacencyBudget = (size_t)atoi(argv[i]) << 20;
+          }
+          else
+          {
+            cout << "Option --adjacency must be followed by a number of MiB." << endl;
+            exit(-1);
+          }
+        }
+        else if (string(argv[i]) == "--matrix")
+        {
+          matrixMode = true;
+        }
+        else if (string(argv[i]) == "--ordered")
+        {
+          orderedJobs = true;
+        }
+        else
+        {
+          cout << "Option \"" << argv[i] << "\" not taken into account" << endl;
+          exit(-1);
+        }
+        break;
       case 'h':
         printHelp();
         return 0;
@@ -337,12 +934,38 @@ int main(int argc, char **argv)
         break;
       case 'f':
         Globals::filteringValue = atoi(argv[i] + 2);
+        filterings = argv[i] + 2;
         break;
       case 'o':
         Globals::orderingValue = atoi(argv[i] + 2);
+        orderings = argv[i] + 2;
         break;
       case 'n':
         Globals::nodeFilteringValue = atoi(argv[i] + 2);
+        nodeFilterings = argv[i] + 2;
+        break;
+      case 'P':
+        Globals::pivotValue = atoi(argv[i] + 2);
+        pivots = argv[i] + 2;
+        break;
+      case 'T':
+        if (atoi(argv[i] + 2) < 1)
+        {
+          cout << "Option -T<i> expects a positive number of threads." << endl;
+          exit(-1);
+        }
+        Globals::parsingThreads = atoi(argv[i] + 2);
+        break;
+      case 'J':
+        if (++i < argc && atoi(argv[i]) > 0)
+        {
+          jobs = atoi(argv[i]);
+        }
+        else
+        {
+          cout << "Option -J must be followed by a positive number of workers." << endl;
+          exit(-1);
+        }
         break;
       case 'i':
         if (++i < argc)
@@ -412,20 +1035,79 @@ int main(int argc, char **argv)
     Utils::printFiltering();
     Utils::printOrdering();
     Utils::printNodeFiltering();
+    Utils::printPivot();
 
     cout << "c |" << setw(LENGTH) << "|" << endl;
     cout << DLINE << endl;
   }
 
-  if (filei > 0)
+  if (!databaseFile.empty())
+  {
+    string error;
+    database = new RunsDatabase();
+    databaseOwner = getpid();
+    if (!database->open(databaseFile, error))
+    {
+      cout << "Cannot open the database " << databaseFile << ": " << error << "." << endl;
+      exit(-1);
+    }
+  }
+
+  if (!cacheDirectory.empty())
+  {
+    string error;
+    cache = new ResultCache();
+    if (!cache->open(cacheDirectory, error))
+    {
+      cout << "Option --cache: " << error << "." << endl;
+      exit(-1);
+    }
+  }
+
+  if (matrixMode)
+  {
+    if (!jobFile.empty())
+    {
+      cout << "Option --matrix cannot be used with --jobs." << endl;
+      exit(-1);
+    }
+    vector<unsigned int> o = readValues(orderings, Globals::orderingValue);
+    vector<unsigned int> f = readValues(filterings, Globals::filteringValue);
+    vector<unsigned int> n = readValues(nodeFilterings, Globals::nodeFilteringValue);
+    vector<unsigned int> p = readValues(pivots, Globals::pivotValue);
+    for (unsigned int ordering : o)
+      for (unsigned int filtering : f)
+        for (unsigned int nodeFiltering : n)
+          for (unsigned int pivot : p)
+            matrix.push_back({ordering, filtering, nodeFiltering, pivot});
+
+    // The Bloom filter is built while parsing
+    if (find(f.begin(), f.end(), (unsigned int)BLOOM_FILTER) != f.end())
+      Globals::filteringValue = BLOOM_FILTER;
+  }
+
+  if (!jobFile.empty())
+  {
+    if (!saveBin.empty())
+    {
+      cout << "Option --save-bin expects a single input file." << endl;
+      exit(-1);
+    }
+    doJobs(jobFile);
+  }
+  else if (filei > 0)
   {
     DIR *dir;
     struct dirent *ent;
     struct stat st;
-    int inst = 50;
-    int remain = LENGTH - inst - 3;
+    vector<string> files;
     if ((dir = opendir(argv[filei])) != NULL)
     {
+      if (!saveBin.empty())
+      {
+        cout << "Option --save-bin expects a single input file." << endl;
+        exit(-1);
+      }
       while ((ent = readdir(dir)) != NULL)
       {
         const string directory(argv[filei]);
@@ -439,59 +1121,30 @@ int main(int argc, char **argv)
         if ((st.st_mode & S_IFDIR) != 0)
           continue;
 
-        if (!Globals::statsh && !Globals::json)
-          cout << "c | * " << setw(inst) << full_file_name << setw(remain) << "|" << endl;
-        else if (Globals::statsh && Globals::json)
-          Globals::jsonLine = "{\"bench\": \"" + full_file_name + "\"";
-        else if (Globals::statsh)
-          cout << full_file_name << ",";
-        else
-        {
-          Globals::jsonLine = "{\"bench\": \"" + full_file_name + "\", \"o\": " + to_string(Globals::orderingValue) + ", \"f\": " + to_string(Globals::filteringValue) + ", \"n\": " + to_string(Globals::nodeFilteringValue);
-          if (Globals::timer)
-            Globals::jsonLine += ", \"Timeout\": " + to_string(Globals::timer);
-        }
-
-        file.open(full_file_name, ios::in);
-        file_buf = file.rdbuf();
-
-        doIt(std_in, file_buf);
-        file.close();
+        files.push_back(full_file_name);
       }
       closedir(dir);
-    }
-    else
-    {
-      if (!Globals::statsh && !Globals::json)
-        cout << "c | * " << setw(inst) << argv[filei] << setw(remain) << "|" << endl;
-      else if (Globals::statsh && Globals::json)
-        Globals::jsonLine = "{\"bench\": \"" + string(argv[filei]) + "\"";
-      else if (Globals::statsh)
-        cout << argv[filei] << ",";
-      else
-      {
-        Globals::jsonLine = "{\"bench\": \"" + string(argv[filei]) + "\", \"o\": " + to_string(Globals::orderingValue) + ", \"f\": " + to_string(Globals::filteringValue) + ", \"n\": " + to_string(Globals::nodeFilteringValue);
-        if (Globals::timer)
-          Globals::jsonLine += ", \"Timeout\": " + to_string(Globals::timer);
-      }
-
-      file.open(argv[filei], ios::in);
-      if (file.good())
-      {
-        file_buf = file.rdbuf();
 
-        doIt(std_in, file_buf);
-        file.close();
-      }
+      if (jobs > 1 && !matrixMode)
+        JobPool(jobs, orderedJobs, emit).run(files, [&files](size_t i)
+                                       { doFile(files[i]); });
       else
+        for (const string &file : files)
+          doFile(file);
+    }
+    else if (TarReader::isArchive(argv[filei]))
+    {
+      if (!saveBin.empty())
       {
-        if (!Globals::statsh && !Globals::json)
-          cout << "c | * " << setw(inst) << "FILE NOT FOUND" << setw(remain) << "|" << endl;
-        else if (Globals::statsh && !Globals::json)
-          cout << "FILE NOT FOUND" << endl;
-        else
-          cout << Globals::jsonLine << ", \"err\": \"fileNotFound\"}" << endl;
+        cout << "Option --save-bin expects a single input file." << endl;
+        exit(-1);
       }
+      doArchive(argv[filei]);
+    }
+    else
+    {
+      startFile(argv[filei]);
+      doIt(argv[filei]);
     }
   }
   else
@@ -499,5 +1152,7 @@ int main(int argc, char **argv)
     doIt(std_in, std_in);
   }
 
+  delete database;
+  delete cache;
   return 0;
 }
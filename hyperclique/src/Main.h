@@ -26,6 +26,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include <stdio.h>
 #include <dirent.h>
 #include <sys/stat.h>
+#include <unistd.h>
 #include <htd/main.hpp>
 #include <htd/Hypergraph.hpp>
 #include <htd/main.hpp>
@@ -36,6 +37,13 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "Graph.h"
 #include "CardinalityConstraint.h"
 #include "BronKerbosch.h"
+#include "MappedFile.h"
+#include "Decompressor.h"
+#include "TarReader.h"
+#include "JobPool.h"
+#include "BatchJob.h"
+#include "RunsDatabase.h"
+#include "ResultCache.h"
 
 #include <future>
 #include <thread>
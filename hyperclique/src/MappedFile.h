@@ -0,0 +1,59 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+using namespace std;
+
+/**
+ * Read-only memory mapping of a whole file.
+ * The content is available through `data` and `size` until the file is closed.
+ */
+class MappedFile
+{
+public:
+  const char *data;
+  size_t size;
+
+  MappedFile() : data(NULL), size(0), fd(-1) {}
+  ~MappedFile() { close(); }
+
+  /**
+   * Maps the given file in memory.
+   * Returns `false` if the file cannot be opened or mapped.
+   */
+  bool open(const string &fileName);
+  void close();
+
+  const char *begin() const { return data; }
+  const char *end() const { return data + size; }
+
+private:
+  int fd;
+
+  MappedFile(const MappedFile &);
+  MappedFile &operator=(const MappedFile &);
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,217 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <set>
+#include <map>
+#include <vector>
+#include <functional>
+#include "Constants.h"
+
+using namespace std;
+
+/**
+ * The nodes of the sets and maps built along the enumeration, in blocks of up to `NODE_POOL_BLOCK` bytes carved
+ * from chunks of `NODE_POOL_CHUNK` bytes. A freed block goes to the free list of its size, from which the next
+ * node of that size is taken. The lists and the chunks belong to each thread, so that no lock is taken: a node
+ * must be freed by the thread which allocated it, and thus not be kept in a static container (the methods may run
+ * on threads of their own, see -t). The larger blocks are left to the global allocator.
+ */
+class NodePool
+{
+public:
+  static void *allocate(size_t size)
+  {
+    if (size > NODE_POOL_BLOCK)
+      return ::operator new(size);
+    Pool &pool = local();
+    size_t slot = (size - 1) / GRAIN;
+    pool.live++;
+    Block *block = pool.free[slot];
+    if (block)
+    {
+      pool.free[slot] = block->next;
+      return block;
+    }
+    return pool.carve((slot + 1) * GRAIN);
+  }
+
+  static void deallocate(void *pointer, size_t size)
+  {
+    if (size > NODE_POOL_BLOCK)
+    {
+      ::operator delete(pointer);
+      return;
+    }
+    Pool &pool = local();
+    size_t slot = (size - 1) / GRAIN;
+    Block *block = static_cast<Block *>(pointer);
+    block->next = pool.free[slot];
+    pool.free[slot] = block;
+    pool.live--;
+  }
+
+  /**
+   * Gives the chunks of the calling thread back if none of its nodes is in use anymore (e.g. at the end of a
+   * rank), so that the memory of a large rank is not kept for the next ones. Otherwise, they are kept.
+   */
+  static void release()
+  {
+    Pool &pool = local();
+    if (!pool.live)
+      pool.clear();
+  }
+
+  /* The blocks are multiples of the alignment of the nodes. */
+  static const size_t GRAIN = alignof(max_align_t) < 8 ? alignof(max_align_t) : 8;
+
+private:
+  struct Block
+  {
+    Block *next;
+  };
+
+  struct Pool
+  {
+    Block *free[NODE_POOL_BLOCK / GRAIN];
+    vector<char *> chunks;
+    char *cursor;
+    size_t left;
+    size_t live;
+
+    Pool() : cursor(NULL), left(0), live(0) { fill(free, free + NODE_POOL_BLOCK / GRAIN, (Block *)NULL); }
+
+    void *carve(size_t size)
+    {
+      if (left < size)
+      {
+        cursor = static_cast<char *>(::operator new(NODE_POOL_CHUNK));
+        chunks.push_back(cursor);
+        left = NODE_POOL_CHUNK;
+      }
+      void *block = cursor;
+      cursor += size;
+      left -= size;
+      return block;
+    }
+
+    void clear()
+    {
+      for (char *chunk : chunks)
+        ::operator delete(chunk);
+      chunks.clear();
+      fill(free, free + NODE_POOL_BLOCK / GRAIN, (Block *)NULL);
+      cursor = NULL;
+      left = 0;
+    }
+  };
+
+  /**
+   * Gives the pool of its thread back when the thread ends, unless some of its nodes are still in use (e.g. in a
+   * container destroyed after the thread-local objects): the pool is then left to them.
+   */
+  struct Owner
+  {
+    ~Owner()
+    {
+      Pool *&pool = pointer();
+      if (pool && !pool->live)
+      {
+        pool->clear();
+        delete pool;
+        pool = NULL;
+      }
+    }
+  };
+
+  /**
+   * Returns the pointer to the pool of the calling thread. Being trivially destructible, it stays valid until the
+   * very end of the thread.
+   */
+  static Pool *&pointer()
+  {
+    static thread_local Pool *pool = NULL;
+    return pool;
+  }
+
+  /**
+   * Returns the pool of the calling thread, created on its first node.
+   */
+  static Pool &local()
+  {
+    Pool *&pool = pointer();
+    if (pool == NULL)
+    {
+      static thread_local Owner owner;
+      (void)owner;
+      pool = new Pool();
+    }
+    return *pool;
+  }
+};
+
+/**
+ * Allocates the nodes of a container (one element at a time) from `NodePool`, and its arrays from the global allocator.
+ */
+template <typename T>
+struct PoolAllocator
+{
+  typedef T value_type;
+
+  static_assert(alignof(T) <= NodePool::GRAIN, "the pooled nodes are aligned on NodePool::GRAIN");
+
+  PoolAllocator() {}
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U> &) {}
+
+  T *allocate(size_t n)
+  {
+    return static_cast<T *>(n == 1 ? NodePool::allocate(sizeof(T)) : ::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *pointer, size_t n)
+  {
+    if (n == 1)
+      NodePool::deallocate(pointer, sizeof(T));
+    else
+      ::operator delete(pointer);
+  }
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T> &, const PoolAllocator<U> &) { return true; }
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T> &, const PoolAllocator<U> &) { return false; }
+
+/* The sets and maps whose nodes come from `NodePool`. */
+template <typename T, typename Compare = less<T>>
+using pool_set = set<T, Compare, PoolAllocator<T>>;
+
+template <typename K, typename V, typename Compare = less<K>>
+using pool_map = map<K, V, Compare, PoolAllocator<pair<const K, V>>>;
+
+#endif // NODE_POOL_H
@@ -0,0 +1,124 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "ResultCache.h"
+#include "MappedFile.h"
+
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <cstdio>
+#include <cerrno>
+#include <climits>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#ifdef __APPLE__
+#include <mach-o/dyld.h>
+#endif
+
+/**
+ * Returns the path of the running executable, or an empty string if it is unknown.
+ */
+static string executablePath()
+{
+  char path[PATH_MAX];
+#ifdef __APPLE__
+  uint32_t size = sizeof(path);
+  if (_NSGetExecutablePath(path, &size) == 0)
+    return path;
+#else
+  ssize_t size = readlink("/proc/self/exe", path, sizeof(path) - 1);
+  if (size > 0)
+    return string(path, size);
+#endif
+  return "";
+}
+
+bool ResultCache::open(const string &directory, string &error)
+{
+  if (mkdir(directory.c_str(), 0755) == -1 && errno != EEXIST)
+  {
+    error = "cannot create the directory " + directory;
+    return false;
+  }
+  this->directory = directory;
+  if (this->directory[this->directory.size() - 1] != '/')
+    this->directory += "/";
+
+  MappedFile executable;
+  if (executable.open(executablePath()))
+    version = hash(executable.begin(), executable.end());
+  else
+    version = __DATE__ " " __TIME__;
+  return true;
+}
+
+string ResultCache::hash(const char *begin, const char *end)
+{
+  uint64_t h = 14695981039346656037ULL;
+  for (const char *p = begin; p < end; p++)
+    h = (h ^ (unsigned char)*p) * 1099511628211ULL;
+
+  char hex[40];
+  snprintf(hex, sizeof(hex), "%016llx-%llx", (unsigned long long)h, (unsigned long long)(end - begin));
+  return hex;
+}
+
+string ResultCache::path(const string &key) const
+{
+  return directory + hash(key.data(), key.data() + key.size());
+}
+
+bool ResultCache::find(const string &key, string &jsonLine, string &output) const
+{
+  ifstream in(path(key).c_str(), ios::binary);
+  string storedKey, storedVersion;
+  if (!getline(in, storedKey) || !getline(in, storedVersion) || !getline(in, jsonLine))
+    return false;
+
+  // A different key with the same hash, or a result of another build
+  if (storedKey != key || storedVersion != version)
+    return false;
+
+  output.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+  return true;
+}
+
+void ResultCache::store(const string &key, const string &jsonLine, const string &output) const
+{
+  string fileName = path(key);
+  string temporary = fileName + "." + to_string(getpid());
+  {
+    ofstream out(temporary.c_str(), ios::binary);
+    out << key << "\n"
+        << version << "\n"
+        << jsonLine << "\n"
+        << output;
+    if (!out)
+    {
+      out.close();
+      remove(temporary.c_str());
+      return;
+    }
+  }
+  rename(temporary.c_str(), fileName.c_str());
+}
@@ -0,0 +1,68 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <string>
+using namespace std;
+
+/**
+ * On-disk cache of the output of the runs, in a directory.
+ *
+ * A run is identified by a key made of the hash of the instance bytes and the options that change its output.
+ * The key is completed with the build version, the hash of the executable itself, so that a rebuilt binary
+ * never reads the results of another one. An entry holds the json line of the file when the run was stored,
+ * followed by the output of the run (json lines or text, with the cliques if they were printed).
+ */
+class ResultCache
+{
+public:
+  /**
+   * Uses (and creates if needed) the directory `directory`.
+   * Returns `false` and sets `error` if the directory cannot be used.
+   */
+  bool open(const string &directory, string &error);
+
+  /**
+   * Returns the 64-bit FNV-1a hash of [begin, end), with its length, in hexadecimal.
+   */
+  static string hash(const char *begin, const char *end);
+
+  /**
+   * Looks for the run `key`: returns `true` and sets `jsonLine` and `output` if it is in the cache.
+   */
+  bool find(const string &key, string &jsonLine, string &output) const;
+
+  /**
+   * Stores the run `key`. The entry is written in a temporary file and renamed,
+   * so that concurrent workers never read a partial entry.
+   */
+  void store(const string &key, const string &jsonLine, const string &output) const;
+
+private:
+  string directory;
+  string version;
+
+  string path(const string &key) const;
+};
+
+#endif // RESULT_CACHE_H
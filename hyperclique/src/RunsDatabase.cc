@@ -0,0 +1,183 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "RunsDatabase.h"
+#include "Constants.h"
+
+#include <sqlite3.h>
+#include <cstdlib>
+
+static const char *CREATE_RUNS =
+    "CREATE TABLE IF NOT EXISTS runs"
+    " (runid Integer primary key AUTOINCREMENT,"
+    " bench varchar(250),"
+    " o int,"
+    " f int,"
+    " n int,"
+    " m CHAR(1) CHECK( m IN ('a','b','c','u') ),"
+    " maxrank int,"
+    " timedout int(1),"
+    " timeout float,"
+    " hyperedges int,"
+    " nodes int,"
+    " totalcliques int,"
+    " parsingtime float,"
+    " totaltime float,"
+    " bktotaltime float,"
+    " totalcalls int);";
+
+/* The columns added since, to the tables created without them (it fails on the others). */
+static const char *ADD_COLUMNS[] = {"ALTER TABLE runs ADD COLUMN pivot int DEFAULT 0;",
+                                    "ALTER TABLE runs ADD COLUMN ranktime float;"};
+
+/* The tables created before -u could be stored: the check on `m` can only change by copying the table. */
+static const char *OLD_CHECK = "CHECK( m IN ('a','b','c') )";
+static const char *RENAME_RUNS = "ALTER TABLE runs RENAME TO runs_abc;";
+static const char *COPY_RUNS = "INSERT INTO runs SELECT * FROM runs_abc; DROP TABLE runs_abc;";
+
+static const char *INSERT_RUN =
+    "INSERT INTO runs (bench, o, f, n, m, maxrank, timedout, timeout, hyperedges, nodes,"
+    " totalcliques, parsingtime, totaltime, bktotaltime, totalcalls, pivot, ranktime)"
+    " VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12, ?13, ?14, ?15, COALESCE(?16, 0), ?17);";
+
+/* The columns of the table, as named in the json line (`timeout` is printed as `Timeout`). */
+static const char *FIELDS[] = {"bench", "o", "f", "n", "m", "maxrank", "timedout", "Timeout", "hyperedges", "nodes",
+                               "totalcliques", "parsingtime", "totaltime", "bktotaltime", "totalcalls", "pivot",
+                               "ranktime"};
+static const int NB_FIELDS = sizeof(FIELDS) / sizeof(FIELDS[0]);
+
+/**
+ * Returns the position of the value of the first field `key` of the json line, or `string::npos`.
+ */
+static size_t findField(const string &line, const char *key)
+{
+  size_t p = line.find("\"" + string(key) + "\": ");
+  return (p == string::npos) ? p : p + string(key).size() + 4;
+}
+
+bool RunsDatabase::open(const string &fileName, string &error)
+{
+  close();
+  bool created = sqlite3_open(fileName.c_str(), &db) == SQLITE_OK && execute(CREATE_RUNS);
+  if (created)
+  {
+    addColumns();
+    if (schema().find(OLD_CHECK) != string::npos)
+    {
+      created = execute("BEGIN;") && execute(RENAME_RUNS) && execute(CREATE_RUNS);
+      if (created)
+        addColumns();
+      created = created && execute(COPY_RUNS) && execute("COMMIT;");
+      if (!created)
+        execute("ROLLBACK;");
+    }
+  }
+  if (!created || sqlite3_prepare_v2(db, INSERT_RUN, -1, &insert, NULL) != SQLITE_OK)
+  {
+    error = (db == NULL) ? "out of memory" : sqlite3_errmsg(db);
+    close();
+    return false;
+  }
+  return true;
+}
+
+void RunsDatabase::close()
+{
+  if (pending > 0)
+    execute("COMMIT;");
+  pending = 0;
+  sqlite3_finalize(insert);
+  insert = NULL;
+  sqlite3_close(db);
+  db = NULL;
+}
+
+bool RunsDatabase::isRun(const string &line)
+{
+  return line.compare(0, 10, "{\"bench\": ") == 0 && findField(line, "m") != string::npos &&
+         findField(line, "err") == string::npos;
+}
+
+bool RunsDatabase::add(const string &line)
+{
+  if (pending == 0 && !execute("BEGIN;"))
+    return false;
+
+  sqlite3_reset(insert);
+  sqlite3_clear_bindings(insert);
+  for (int i = 0; i < NB_FIELDS; i++)
+  {
+    size_t p = findField(line, FIELDS[i]);
+    if (p == string::npos)
+      continue; // NULL, e.g. no timeout
+    if (line[p] == '"')
+    {
+      string text;
+      for (size_t c = p + 1; c < line.size() && line[c] != '"'; c++)
+      {
+        if (line[c] != '\\' || c + 1 == line.size())
+          text += line[c];
+        else if (line[++c] == 'u' && c + 4 < line.size())
+        {
+          text += (char)strtol(line.substr(c + 1, 4).c_str(), NULL, 16);
+          c += 4;
+        }
+        else
+          text += line[c];
+      }
+      sqlite3_bind_text(insert, i + 1, text.data(), text.size(), SQLITE_TRANSIENT);
+    }
+    else
+      sqlite3_bind_double(insert, i + 1, strtod(line.c_str() + p, NULL));
+  }
+
+  bool inserted = (sqlite3_step(insert) == SQLITE_DONE);
+  if (++pending == SQLITE_BATCH)
+  {
+    execute("COMMIT;");
+    pending = 0;
+  }
+  return inserted;
+}
+
+void RunsDatabase::addColumns()
+{
+  for (const char *column : ADD_COLUMNS)
+    execute(column);
+}
+
+string RunsDatabase::schema()
+{
+  string sql;
+  sqlite3_stmt *statement;
+  if (sqlite3_prepare_v2(db, "SELECT sql FROM sqlite_master WHERE type = 'table' AND name = 'runs';", -1,
+                         &statement, NULL) != SQLITE_OK)
+    return sql;
+  if (sqlite3_step(statement) == SQLITE_ROW && sqlite3_column_text(statement, 0) != NULL)
+    sql = (const char *)sqlite3_column_text(statement, 0);
+  sqlite3_finalize(statement);
+  return sql;
+}
+
+bool RunsDatabase::execute(const char *sql)
+{
+  return sqlite3_exec(db, sql, NULL, NULL, NULL) == SQLITE_OK;
+}
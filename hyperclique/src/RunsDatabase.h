@@ -0,0 +1,87 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef RUNS_DATABASE_H
+#define RUNS_DATABASE_H
+
+#include <string>
+using namespace std;
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+/**
+ * Writer of the results in the `runs` table of a sqlite database (see the README for the schema).
+ * A row is made from the json line of a run (the output of -j for one method);
+ * the rows are inserted by transactions of SQLITE_BATCH rows.
+ */
+class RunsDatabase
+{
+public:
+  RunsDatabase() : db(NULL), insert(NULL), pending(0) {}
+  ~RunsDatabase() { close(); }
+
+  /**
+   * Opens (or creates) the database and its `runs` table.
+   * Returns `false` and sets `error` if the database cannot be opened.
+   */
+  bool open(const string &fileName, string &error);
+
+  /**
+   * Commits the pending rows and closes the database.
+   */
+  void close();
+
+  bool isOpen() const { return db != NULL; }
+
+  /**
+   * Returns `true` if `line` is the json line of a run, i.e. a row of the table.
+   */
+  static bool isRun(const string &line);
+
+  /**
+   * Inserts the row of the json line of a run.
+   * Returns `false` if the row cannot be inserted.
+   */
+  bool add(const string &line);
+
+private:
+  sqlite3 *db;
+  sqlite3_stmt *insert;
+  unsigned int pending;
+
+  bool execute(const char *sql);
+
+  /**
+   * Adds to the `runs` table the columns it was created without.
+   */
+  void addColumns();
+
+  /**
+   * Returns the statement that created the `runs` table.
+   */
+  string schema();
+
+  RunsDatabase(const RunsDatabase &);
+  RunsDatabase &operator=(const RunsDatabase &);
+};
+
+#endif // RUNS_DATABASE_H
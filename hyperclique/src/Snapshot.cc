@@ -0,0 +1,161 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "Snapshot.h"
+#include "Graph.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+static const char MAGIC[4] = {'H', 'G', 'B', 'S'};
+
+bool Snapshot::isSnapshot(const char *begin, const char *end)
+{
+  return (size_t)(end - begin) >= sizeof(MAGIC) && memcmp(begin, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+/**
+ * Returns `true` if the `n + 1` offsets are non decreasing and bounded by `max`.
+ */
+static bool checkOffsets(const uint32_t *offsets, uint32_t n, uint32_t max)
+{
+  if (offsets[0] != 0 || offsets[n] != max)
+    return false;
+  for (uint32_t i = 0; i < n; i++)
+  {
+    if (offsets[i] > offsets[i + 1])
+      return false;
+  }
+  return true;
+}
+
+Snapshot::Snapshot(const char *begin, const char *end) : valid(false), header(NULL)
+{
+  if (!isSnapshot(begin, end) || (size_t)(end - begin) < sizeof(Header))
+    return;
+  header = (const Header *)begin;
+  if (header->version != VERSION)
+    return;
+
+  const uint32_t *p = (const uint32_t *)(begin + sizeof(Header));
+  const uint32_t *last = (const uint32_t *)end;
+  uint64_t needed = 2ULL * header->edgeCount + 1 + header->incidenceCount +
+                    3ULL * header->rankCount + 2 + header->edgeCount + header->rankVertexCount;
+  if ((uint64_t)(last - p) < needed)
+    return;
+
+  edgeIds = p;
+  edgeOffsets = edgeIds + header->edgeCount;
+  edgeVertices = edgeOffsets + header->edgeCount + 1;
+  ranks = edgeVertices + header->incidenceCount;
+  rankEdgeOffsets = ranks + header->rankCount;
+  rankEdges = rankEdgeOffsets + header->rankCount + 1;
+  rankVertexOffsets = rankEdges + header->edgeCount;
+  rankVertices = rankVertexOffsets + header->rankCount + 1;
+
+  if (!checkOffsets(edgeOffsets, header->edgeCount, header->incidenceCount) ||
+      !checkOffsets(rankEdgeOffsets, header->rankCount, header->edgeCount) ||
+      !checkOffsets(rankVertexOffsets, header->rankCount, header->rankVertexCount))
+    return;
+  for (uint32_t i = 0; i < header->incidenceCount; i++)
+  {
+    if (edgeVertices[i] >= header->vertexRows)
+      return;
+  }
+  /* The ids are stored in increasing order: the rank lists are checked by binary search. */
+  for (uint32_t e = 1; e < header->edgeCount; e++)
+  {
+    if (edgeIds[e - 1] >= edgeIds[e])
+      return;
+  }
+  for (uint32_t i = 0; i < header->edgeCount; i++)
+  {
+    if (!binary_search(edgeIds, edgeIds + header->edgeCount, rankEdges[i]))
+      return;
+  }
+  for (uint32_t i = 0; i < header->rankVertexCount; i++)
+  {
+    if (rankVertices[i] >= header->vertexRows)
+      return;
+  }
+  valid = true;
+}
+
+bool Snapshot::save(const SweetHBK::Graph &graph, const string &fileName)
+{
+  Header h;
+  memcpy(h.magic, MAGIC, sizeof(MAGIC));
+  h.version = VERSION;
+  h.nbVertices = graph.vertices.size();
+  h.nbEdges = graph.nbHyperedges;
+  h.biggestHyperedge = graph.biggestHyperedge;
+  h.edgeCount = graph.edges.size();
+  h.incidenceCount = 0;
+  h.rankCount = graph.laurentToEdges.size();
+  h.rankVertexCount = 0;
+  h.vertexRows = h.nbVertices + 1;
+
+  vector<uint32_t> ids, offsets(1, 0), elements;
+  ids.reserve(h.edgeCount);
+  offsets.reserve(h.edgeCount + 1);
+  for (const auto &edge : graph.edges)
+  {
+    ids.push_back(edge.first);
+    for (vertex_t v : edge.second)
+    {
+      elements.push_back(v);
+      if (v >= h.vertexRows)
+        h.vertexRows = v + 1;
+    }
+    offsets.push_back(elements.size());
+  }
+  h.incidenceCount = elements.size();
+
+  vector<uint32_t> ranks, rankEdgeOffsets(1, 0), rankEdges;
+  vector<uint32_t> rankVertexOffsets(1, 0), rankVertices;
+  for (const auto &le : graph.laurentToEdges)
+  {
+    ranks.push_back(le.first);
+    rankEdges.insert(rankEdges.end(), le.second.begin(), le.second.end());
+    rankEdgeOffsets.push_back(rankEdges.size());
+
+    map<id_t, set<vertex_t>>::const_iterator lv = graph.laurentToVertices.find(le.first);
+    if (lv != graph.laurentToVertices.end())
+      rankVertices.insert(rankVertices.end(), lv->second.begin(), lv->second.end());
+    rankVertexOffsets.push_back(rankVertices.size());
+  }
+  h.rankVertexCount = rankVertices.size();
+  if (rankEdges.size() != h.edgeCount)
+    return false;
+
+  FILE *out = fopen(fileName.c_str(), "wb");
+  if (out == NULL)
+    return false;
+  bool ok = fwrite(&h, sizeof(h), 1, out) == 1;
+  const vector<uint32_t> *arrays[] = {&ids, &offsets, &elements, &ranks, &rankEdgeOffsets, &rankEdges,
+                                      &rankVertexOffsets, &rankVertices};
+  for (const vector<uint32_t> *a : arrays)
+  {
+    if (ok && !a->empty())
+      ok = fwrite(a->data(), sizeof(uint32_t), a->size(), out) == a->size();
+  }
+  return (fclose(out) == 0) && ok;
+}
@@ -0,0 +1,90 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+#include <string>
+using namespace std;
+
+namespace SweetHBK
+{
+  class Graph;
+}
+
+/**
+ * Binary snapshot (`.hgb`) of a parsed hypergraph.
+ *
+ * The file is a header followed by 32-bit arrays in the native byte order:
+ *  - the hyperedges in CSR form (ids, offsets, sorted vertices),
+ *  - the hyperedge ids and the vertices of each rank (ranks, offsets, values).
+ * A snapshot is read through a single mapping of the file: this class only points into it.
+ */
+class Snapshot
+{
+public:
+  static const uint32_t VERSION = 1;
+
+  struct Header
+  {
+    char magic[4];
+    uint32_t version;
+    uint32_t nbVertices;       // as declared in the input
+    uint32_t nbEdges;          // as declared in the input
+    uint32_t biggestHyperedge;
+    uint32_t edgeCount;        // number of stored hyperedges
+    uint32_t incidenceCount;   // sum of the sizes of the stored hyperedges
+    uint32_t rankCount;
+    uint32_t rankVertexCount;  // sum of the number of vertices of each rank
+    uint32_t vertexRows;       // highest vertex + 1
+  };
+
+  bool valid;
+  const Header *header;
+  const uint32_t *edgeIds;
+  const uint32_t *edgeOffsets;
+  const uint32_t *edgeVertices;
+  const uint32_t *ranks;
+  const uint32_t *rankEdgeOffsets;
+  const uint32_t *rankEdges;
+  const uint32_t *rankVertexOffsets;
+  const uint32_t *rankVertices;
+
+  /**
+   * Maps the arrays of the snapshot stored in the given buffer.
+   * `valid` is `false` if the buffer is not a complete and consistent snapshot.
+   */
+  Snapshot(const char *begin, const char *end);
+
+  /**
+   * Returns `true` if the given buffer starts like a snapshot.
+   */
+  static bool isSnapshot(const char *begin, const char *end);
+
+  /**
+   * Writes the snapshot of `graph` in `fileName`.
+   * Returns `false` if the file cannot be written.
+   */
+  static bool save(const SweetHBK::Graph &graph, const string &fileName);
+};
+
+#endif // SNAPSHOT_H
@@ -22,17 +22,18 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #ifndef STATC_H
 #define STATC_H
 
-#include "Utils.h"
+#include "CliqueStore.h"
+#include "NodePool.h"
 
 class Statc
 {
 public:
-  map<vertex_t, set<int>> vclique;
+  pool_map<vertex_t, pool_set<int>> vclique;
 
-  Statc(set<set<vertex_t>> cliques)
+  Statc(const CliqueStore &cliques)
   {
     int i = 0;
-    for (const set<vertex_t> &clique : cliques)
+    for (const SortedRange<vertex_t> clique : cliques)
     {
       for (const vertex_t v : clique)
       {
@@ -62,10 +63,10 @@ public:
   int nCliques(set<vertex_t> vertices)
   {
     set<vertex_t>::iterator v = vertices.begin();
-    set<int> result = vclique[*v];
+    pool_set<int> result = vclique[*v];
     for (v++; v != vertices.end(); v++)
     {
-      result = Utils::set_intersection(result, vclique[*v]);
+      Utils::intersect_with(result, vclique[*v]);
     }
     return result.size();
   }
@@ -76,10 +77,10 @@ public:
   int nCliques(vector<vertex_t> vertices)
   {
     vector<vertex_t>::iterator v = vertices.begin();
-    set<int> result(v, vertices.end());
+    pool_set<int> result(v, vertices.end());
     for (v++; v != vertices.end(); v++)
     {
-      result = Utils::set_intersection(result, vclique[*v]);
+      Utils::intersect_with(result, vclique[*v]);
     }
     return result.size();
   }
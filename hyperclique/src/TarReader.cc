@@ -0,0 +1,228 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "TarReader.h"
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+#define TAR_BLOCK 512
+
+TarReader::MemberBuffer::int_type TarReader::MemberBuffer::underflow()
+{
+  if (gptr() < egptr())
+    return traits_type::to_int_type(*gptr());
+  if (remaining == 0)
+    return traits_type::eof();
+
+  streamsize n = archive->sgetn(buffer.data(), min(remaining, buffer.size()));
+  if (n <= 0)
+  {
+    *truncated = true;
+    return traits_type::eof();
+  }
+  remaining -= n;
+  setg(buffer.data(), buffer.data(), buffer.data() + n);
+  return traits_type::to_int_type(*gptr());
+}
+
+streamsize TarReader::MemberBuffer::xsgetn(char *s, streamsize n)
+{
+  /* What is left in the buffer first, then straight from the archive */
+  streamsize buffered = min(n, (streamsize)(egptr() - gptr()));
+  memcpy(s, gptr(), buffered);
+  gbump(buffered);
+
+  streamsize direct = min((size_t)(n - buffered), remaining);
+  if (direct > 0)
+  {
+    streamsize read = max((streamsize)0, archive->sgetn(s + buffered, direct));
+    if (read < direct)
+      *truncated = true;
+    direct = read;
+  }
+  remaining -= direct;
+  return buffered + direct;
+}
+
+TarReader::TarReader(streambuf *archive) : corrupted(false), archive(archive), content(archive, &corrupted), padding(0) {}
+
+bool TarReader::isArchive(const string &fileName)
+{
+  const char *extensions[] = {".tar", ".tbz", ".tbz2", ".tar.bz2", ".tgz", ".tar.gz", ".tzst", ".tar.zst"};
+  for (const char *extension : extensions)
+  {
+    size_t length = strlen(extension);
+    if (fileName.size() > length && fileName.compare(fileName.size() - length, length, extension) == 0)
+      return true;
+  }
+  return false;
+}
+
+bool TarReader::read(char *buffer, size_t size)
+{
+  return archive->sgetn(buffer, size) == (streamsize)size;
+}
+
+bool TarReader::skip(size_t size)
+{
+  char buffer[TAR_BLOCK * 8];
+  while (size > 0)
+  {
+    size_t n = min(size, sizeof(buffer));
+    if (!read(buffer, n))
+      return false;
+    size -= n;
+  }
+  return true;
+}
+
+/**
+ * Decodes a numeric field of a header: octal digits, or base-256 for large values.
+ */
+static size_t readNumber(const char *field, size_t length)
+{
+  size_t value = 0;
+  if ((unsigned char)field[0] & 0x80)
+  {
+    value = (unsigned char)field[0] & 0x7f;
+    for (size_t i = 1; i < length; i++)
+      value = (value << 8) | (unsigned char)field[i];
+    return value;
+  }
+  for (size_t i = 0; i < length && field[i] != '\0'; i++)
+  {
+    if (field[i] >= '0' && field[i] <= '7')
+      value = value * 8 + (field[i] - '0');
+  }
+  return value;
+}
+
+/**
+ * Returns the content of a string field, which is not null-terminated when it is full.
+ */
+static string readString(const char *field, size_t length)
+{
+  return string(field, strnlen(field, length));
+}
+
+/**
+ * Returns `true` if the checksum of the header is correct
+ * (computed with unsigned and, for old archivers, signed bytes).
+ */
+static bool checkHeader(const char *header)
+{
+  size_t expected = readNumber(header + 148, 8);
+  long unsignedSum = 0, signedSum = 0;
+  for (int i = 0; i < TAR_BLOCK; i++)
+  {
+    char c = (i >= 148 && i < 156) ? ' ' : header[i];
+    unsignedSum += (unsigned char)c;
+    signedSum += (signed char)c;
+  }
+  return (long)expected == unsignedSum || (long)expected == signedSum;
+}
+
+bool TarReader::next()
+{
+  if (corrupted || !skip(content.remaining + padding))
+  {
+    corrupted = true;
+    return false;
+  }
+  content.reset(0);
+  padding = 0;
+
+  string longName;
+  char header[TAR_BLOCK];
+  while (true)
+  {
+    if (!read(header, TAR_BLOCK))
+    {
+      // An archive without its final empty blocks
+      return false;
+    }
+    if (header[0] == '\0')
+      return false; // end of archive
+
+    if (!checkHeader(header))
+    {
+      corrupted = true;
+      return false;
+    }
+
+    size_t size = readNumber(header + 124, 12);
+    size_t pad = (TAR_BLOCK - size % TAR_BLOCK) % TAR_BLOCK;
+    char type = header[156];
+
+    if (type == 'L' || type == 'x')
+    {
+      /* GNU long name or pax extended header of the next member */
+      string data(size, '\0');
+      if (!read(&data[0], size) || !skip(pad))
+      {
+        corrupted = true;
+        return false;
+      }
+      if (type == 'L')
+        longName = readString(data.data(), size);
+      else
+      {
+        /* Records "<length> <key>=<value>\n" */
+        size_t p = 0;
+        while (p < data.size())
+        {
+          size_t length = strtoul(data.c_str() + p, NULL, 10);
+          if (length == 0 || p + length > data.size())
+            break;
+          size_t key = data.find(' ', p) + 1;
+          if (data.compare(key, 5, "path=") == 0)
+            longName = data.substr(key + 5, p + length - key - 6);
+          p += length;
+        }
+      }
+      continue;
+    }
+
+    if (type != '0' && type != '\0' && type != '7')
+    {
+      /* Directories, links and other entries have no content to visit */
+      if (!skip(size + pad))
+      {
+        corrupted = true;
+        return false;
+      }
+      longName.clear();
+      continue;
+    }
+
+    if (!longName.empty())
+      name = longName;
+    else if (memcmp(header + 257, "ustar", 5) == 0 && header[345] != '\0')
+      name = readString(header + 345, 155) + "/" + readString(header, 100);
+    else
+      name = readString(header, 100);
+
+    content.reset(size);
+    padding = pad;
+    return true;
+  }
+}
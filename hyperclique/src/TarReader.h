@@ -0,0 +1,110 @@
+/************************************************************************************
+Copyright (c) 2020 Marie Pelleau, Université Côte d'Azur, I3S, France
+Copyright (c) 2020 Laurent Simon, Bordeaux INP, Université de Bordeaux, LaBRI, Talence, France
+Last edit, March 2, 2020
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef TAR_READER_H
+#define TAR_READER_H
+
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <cstddef>
+using namespace std;
+
+/**
+ * Sequential reader of a tar archive (ustar, GNU and pax names) given as a stream,
+ * e.g. a decompressed `.tbz` file.
+ * The regular files of the archive are visited in turn and their content is read
+ * directly from the archive stream: nothing is extracted on disk.
+ */
+class TarReader
+{
+public:
+  /**
+   * Name of the current member, as stored in the archive.
+   */
+  string name;
+
+  /**
+   * `true` if the archive is not a valid tar stream (e.g. a wrong header checksum or a truncated member).
+   */
+  bool corrupted;
+
+  TarReader(streambuf *archive);
+
+  /**
+   * Moves to the next regular file of the archive, skipping what remains of the current one.
+   * Returns `false` at the end of the archive.
+   */
+  bool next();
+
+  /**
+   * The content of the current member, which can be read once.
+   */
+  streambuf *member() { return &content; }
+
+  /**
+   * Returns `true` if the file name has the extension of a (possibly compressed) tar archive.
+   */
+  static bool isArchive(const string &fileName);
+
+private:
+  /**
+   * A window of the archive stream limited to the content of the current member.
+   */
+  class MemberBuffer : public streambuf
+  {
+  public:
+    streambuf *archive;
+    size_t remaining;
+
+    /**
+     * Set when the archive stream ends before the content of the member.
+     */
+    bool *truncated;
+
+    MemberBuffer(streambuf *archive, bool *truncated) : archive(archive), remaining(0), truncated(truncated), buffer(4096) {}
+
+    /**
+     * Starts the content of a member of `size` bytes.
+     */
+    void reset(size_t size)
+    {
+      remaining = size;
+      setg(NULL, NULL, NULL);
+    }
+
+  protected:
+    int_type underflow();
+    streamsize xsgetn(char *s, streamsize n);
+
+  private:
+    vector<char> buffer;
+  };
+
+  streambuf *archive;
+  MemberBuffer content;
+  size_t padding;
+
+  bool read(char *buffer, size_t size);
+  bool skip(size_t size);
+};
+
+#endif // TAR_READER_H
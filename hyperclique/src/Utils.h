@@ -22,14 +22,169 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <cstdio>
 #include <set>
 #include <map>
+#include <string>
 #include <htd/main.hpp>
 #include "Constants.h"
 #include "Globals.h"
 
 using namespace htd;
 
+/**
+ * A read-only view of a sorted array, e.g. a row of the flat incidence structure of `HBKGraph`.
+ */
+template <typename T>
+struct SortedRange
+{
+  const T *first;
+  const T *last;
+
+  SortedRange(const T *first, const T *last) : first(first), last(last) {}
+  explicit SortedRange(const vector<T> &elements) : first(elements.data()), last(elements.data() + elements.size()) {}
+
+  const T *begin() const { return first; }
+  const T *end() const { return last; }
+  size_t size() const { return last - first; }
+  bool empty() const { return first == last; }
+  bool contains(const T &e) const { return binary_search(first, last, e); }
+};
+
+/**
+ * A sorted set stored in a sorted array, inline up to `N` elements and on the heap beyond, so that
+ * building and copying the small sets of the enumeration (its cliques) does not touch the allocator.
+ */
+template <typename T, size_t N>
+class SmallSet
+{
+public:
+  typedef const T *const_iterator;
+
+  SmallSet() : data(buffer), length(0), capacity(N) {}
+
+  /**
+   * Creates the set of the elements [first, last), in any order.
+   */
+  template <typename I>
+  SmallSet(I first, I last) : SmallSet()
+  {
+    for (; first != last; ++first)
+      insert(*first);
+  }
+
+  SmallSet(const SmallSet &other) : SmallSet() { assign(other); }
+  SmallSet(SmallSet &&other) : SmallSet() { take(other); }
+
+  SmallSet &operator=(const SmallSet &other)
+  {
+    if (this != &other)
+      assign(other);
+    return *this;
+  }
+
+  SmallSet &operator=(SmallSet &&other)
+  {
+    if (this != &other)
+      take(other);
+    return *this;
+  }
+
+  ~SmallSet()
+  {
+    if (data != buffer)
+      delete[] data;
+  }
+
+  const T *begin() const { return data; }
+  const T *end() const { return data + length; }
+  size_t size() const { return length; }
+  bool empty() const { return length == 0; }
+  size_t count(const T &e) const { return binary_search(begin(), end(), e); }
+
+  /**
+   * Adds `e` at its place. Returns `true` if it was not already there.
+   */
+  bool insert(const T &e)
+  {
+    size_t position = lower_bound(begin(), end(), e) - data;
+    if (position < length && data[position] == e)
+      return false;
+    if (length == capacity)
+      reserve(2 * capacity);
+    copy_backward(data + position, data + length, data + length + 1);
+    data[position] = e;
+    length++;
+    return true;
+  }
+
+  /**
+   * Removes `e`. Returns the number of elements removed (0 or 1).
+   */
+  size_t erase(const T &e)
+  {
+    T *position = lower_bound(data, data + length, e);
+    if (position == data + length || *position != e)
+      return 0;
+    copy(position + 1, data + length, position);
+    length--;
+    return 1;
+  }
+
+  void clear() { length = 0; }
+
+private:
+  T buffer[N];
+  T *data;
+  size_t length;
+  size_t capacity;
+
+  void reserve(size_t size)
+  {
+    if (size <= capacity)
+      return;
+    T *grown = new T[size];
+    copy(data, data + length, grown);
+    if (data != buffer)
+      delete[] data;
+    data = grown;
+    capacity = size;
+  }
+
+  void assign(const SmallSet &other)
+  {
+    reserve(other.length);
+    copy(other.begin(), other.end(), data);
+    length = other.length;
+  }
+
+  /**
+   * Moves the elements of `other`, stealing them if they are on the heap.
+   */
+  void take(SmallSet &other)
+  {
+    if (other.data == other.buffer)
+    {
+      assign(other);
+      other.length = 0;
+      return;
+    }
+    if (data != buffer)
+      delete[] data;
+    data = other.data;
+    length = other.length;
+    capacity = other.capacity;
+    other.data = other.buffer;
+    other.length = 0;
+    other.capacity = N;
+  }
+};
+
+/**
+ * The vertices of a clique under construction.
+ */
+typedef SmallSet<vertex_t, CLIQUE_CAPACITY> clique_t;
+
 class Utils
 {
 public:
@@ -64,6 +219,46 @@ public:
     return res;
   }
 
+  /**
+   * Returns the 64-bit FNV-1a hash of the vertices [first, last).
+   */
+  static uint64_t hash(const vertex_t *first, const vertex_t *last)
+  {
+    uint64_t h = 14695981039346656037ULL;
+    for (; first != last; first++)
+    {
+      h ^= *first;
+      h *= 1099511628211ULL;
+    }
+    return h;
+  }
+
+  /********************************/
+  /************ Strings ***********/
+  /********************************/
+
+  /**
+   * Returns `s` as a json string literal, quotes included.
+   */
+  static string jsonString(const string &s)
+  {
+    string quoted = "\"";
+    for (unsigned char c : s)
+    {
+      if (c == '"' || c == '\\')
+        quoted += '\\';
+      if (c < 0x20)
+      {
+        char escaped[8];
+        snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+        quoted += escaped;
+      }
+      else
+        quoted += c;
+    }
+    return quoted + "\"";
+  }
+
   /********************************/
   /************** Set *************/
   /********************************/
@@ -72,7 +267,7 @@ public:
    * A function to print all combinations of a given length from the given array.
    */
   static void generateSubSets(vector<vertex_t> &a, unsigned int reqLen, unsigned int start,
-                              set<vertex_t> &current, vector<set<vertex_t>> &res)
+                              clique_t &current, vector<clique_t> &res)
   {
 
     if (current.size() > reqLen)
@@ -105,7 +300,7 @@ public:
    * Returns `true` if `b` is included in `a`, `false` otherwise.
    */
   template <typename T>
-  static bool is_included(vector<T> a, vector<T> b)
+  static bool is_included(const vector<T> &a, const vector<T> &b)
   {
     return includes(a.begin(), a.end(), b.begin(), b.end());
   }
@@ -115,7 +310,7 @@ public:
    * Returns `true` if `b` is included in `a`, `false` otherwise.
    */
   template <typename T>
-  static bool is_included(set<T> a, set<T> b)
+  static bool is_included(const set<T> &a, const set<T> &b)
   {
     return includes(a.begin(), a.end(), b.begin(), b.end());
   }
@@ -125,7 +320,7 @@ public:
    * Returns `true` if `b` is included in `a`, `false` otherwise.
    */
   template <typename T>
-  static bool is_included(set<set<T>> a, set<T> b)
+  static bool is_included(const set<set<T>> &a, const set<T> &b)
   {
     for (const set<T> &s : a)
     {
@@ -139,10 +334,10 @@ public:
    * Computes the union of two sets.
    */
   template <typename T>
-  static set<T> set_union(set<T> a, set<T> b)
+  static set<T> set_union(const set<T> &a, const set<T> &b)
   {
     set<T> c;
-    std::merge(a.begin(), a.end(), b.begin(), b.end(), inserter(c, c.end()));
+    set_union(a, b, c);
     return c;
   }
 
@@ -150,11 +345,10 @@ public:
    * Computes the union of a vector and a set.
    */
   template <typename T>
-  static set<T> set_union(vector<T> a, set<T> b)
+  static set<T> set_union(const vector<T> &a, const set<T> &b)
   {
-    set<T> c;
-    sort(a.begin(), a.end());
-    std::merge(a.begin(), a.end(), b.begin(), b.end(), inserter(c, c.end()));
+    set<T> c(b);
+    c.insert(a.begin(), a.end());
     return c;
   }
 
@@ -162,81 +356,33 @@ public:
    * Computes the union of a set and a vector.
    */
   template <typename T>
-  static set<T> set_union(set<T> a, vector<T> b) { return set_union(b, a); }
+  static set<T> set_union(const set<T> &a, const vector<T> &b) { return set_union(b, a); }
 
   /**
    * Computes the union of a ConstCollection and a set.
    */
   template <typename T>
-  static set<T> set_union(ConstCollection<T> a, set<T> b) { return set_union(toSet(a), b); }
-
-  /**
-   * Computes the union of a set and a ConstCollection.
-   */
-  template <typename T>
-  static set<T> set_union(set<T> a, ConstCollection<T> b) { return set_union(b, a); }
-
-  /**
-   * Computes the union of two sets with comparator.
-   */
-  template <typename T, typename C>
-  static set<T, C> set_union(set<T, C> a, set<T, C> b, C comp)
+  static set<T> set_union(const ConstCollection<T> &a, const set<T> &b)
   {
-    set<T, C> c(comp);
-    std::merge(a.begin(), a.end(), b.begin(), b.end(), inserter(c, c.end()), comp);
+    set<T> c(b);
+    c.insert(a.begin(), a.end());
     return c;
   }
 
   /**
-   * Computes the union of two sets with comparator.
-   */
-  template <typename T, typename C>
-  static set<T, C> set_union(set<T, C> a, set<T> b, C comp)
-  {
-    set<T, C> bBis(comp);
-    for (T e : b)
-      bBis.insert(e);
-    return set_union(a, bBis, comp);
-  }
-
-  /**
-   * Computes the union of two sets with comparator.
-   */
-  template <typename T, typename C>
-  static set<T, C> set_union(set<T> a, set<T, C> b, C comp)
-  {
-    return set_union(b, a, comp);
-  }
-
-  /**
-   * Computes the union of two sets with comparator.
-   */
-  template <typename T, typename C>
-  static set<T, C> set_union(set<T, C> a, vector<T> b, C comp)
-  {
-    set<T, C> bBis(comp);
-    for (T t : b)
-      bBis.insert(t);
-    return set_union(a, bBis, comp);
-  }
-
-  /**
-   * Computes the union of two sets with comparator.
+   * Computes the union of a set and a ConstCollection.
    */
-  template <typename T, typename C>
-  static set<T, C> set_union(vector<T> a, set<T, C> b, C comp)
-  {
-    return set_union(b, a, comp);
-  }
+  template <typename T>
+  static set<T> set_union(const set<T> &a, const ConstCollection<T> &b) { return set_union(b, a); }
 
   /**
    * Computes the intersection of two sets.
    */
   template <typename T>
-  static set<T> set_intersection(set<T> a, set<T> b)
+  static set<T> set_intersection(const set<T> &a, const set<T> &b)
   {
     set<T> c;
-    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), inserter(c, c.end()));
+    set_intersection(a, b, c);
     return c;
   }
 
@@ -244,11 +390,14 @@ public:
    * Computes the intersection of a vector and a set.
    */
   template <typename T>
-  static set<T> set_intersection(vector<T> a, set<T> b)
+  static set<T> set_intersection(const vector<T> &a, const set<T> &b)
   {
     set<T> c;
-    sort(a.begin(), a.end());
-    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), inserter(c, c.end()));
+    for (const T &e : a)
+    {
+      if (b.count(e))
+        c.insert(e);
+    }
     return c;
   }
 
@@ -256,169 +405,194 @@ public:
    * Computes the intersection of a set and a vector.
    */
   template <typename T>
-  static set<T> set_intersection(set<T> a, vector<T> b) { return set_intersection(b, a); }
+  static set<T> set_intersection(const set<T> &a, const vector<T> &b) { return set_intersection(b, a); }
 
   /**
    * Computes the intersection of a ConstCollection and a set.
    */
   template <typename T>
-  static set<T> set_intersection(ConstCollection<T> a, set<T> b) { return set_intersection(toSet(a), b); }
+  static set<T> set_intersection(const ConstCollection<T> &a, const set<T> &b)
+  {
+    set<T> c;
+    for (const T &e : a)
+    {
+      if (b.count(e))
+        c.insert(e);
+    }
+    return c;
+  }
 
   /**
    * Computes the intersection of a set and a ConstCollection.
    */
   template <typename T>
-  static set<T> set_intersection(set<T> a, ConstCollection<T> b) { return set_intersection(b, a); }
+  static set<T> set_intersection(const set<T> &a, const ConstCollection<T> &b) { return set_intersection(b, a); }
 
   /**
-   * Computes the intersection of two sets with comparator.
+   * Computes the difference of two sets `a`and `b`.
+   * Returns `a\b`.
    */
-  template <typename T, typename C>
-  static set<T, C> set_intersection(set<T, C> a, set<T, C> b, C comp)
+  template <typename T>
+  static set<T> set_difference(const set<T> &a, const set<T> &b)
   {
-    set<T> aBis, bBis, cBis;
-    for (T e : a)
-      aBis.insert(e);
-    for (T e : b)
-      bBis.insert(e);
-    cBis = set_intersection(aBis, bBis);
-    set<T, C> c(comp);
-    for (T e : cBis)
-      c.insert(e);
+    set<T> c;
+    set_difference(a, b, c);
     return c;
   }
 
   /**
-   * Computes the intersection of two sets with comparator.
+   * Computes the difference of a vector `a` and a set `b`.
+   * Returns `a\b`.
    */
-  template <typename T, typename C>
-  static set<T, C> set_intersection(set<T, C> a, set<T> b, C comp)
+  template <typename T>
+  static set<T> set_difference(const vector<T> &a, const set<T> &b)
   {
-    set<T> aBis;
-    for (T e : a)
-      aBis.insert(e);
-    set<T> cBis = set_intersection(aBis, b);
-    set<T, C> c(comp);
-    for (T e : cBis)
-      c.insert(e);
+    set<T> c;
+    for (const T &e : a)
+    {
+      if (!b.count(e))
+        c.insert(e);
+    }
     return c;
   }
 
   /**
-   * Computes the intersection of two sets with comparator.
-   */
-  template <typename T, typename C>
-  static set<T, C> set_intersection(set<T> a, set<T, C> b, C comp)
-  {
-    return set_intersection(b, a, comp);
-  }
-
-  /**
-   * Computes the intersection of a ConstCollection and a set.
+   * Computes the difference of a set `a` and a vector `b`.
+   * Returns `a\b`.
    */
-  template <typename T, typename C>
-  static set<T, C> set_intersection(ConstCollection<T> a, set<T, C> b, C comp)
+  template <typename T>
+  static set<T> set_difference(const set<T> &a, const vector<T> &b)
   {
-    return set_intersection(toSet(a), b, comp);
+    set<T> c(a);
+    for (const T &e : b)
+      c.erase(e);
+    return c;
   }
 
   /**
-   * Computes the intersection of a set and a ConstCollection.
+   * Computes the difference of a ConstCollection `a` and a set `b`.
+   * Returns `a\b`.
    */
-  template <typename T, typename C>
-  static set<T, C> set_intersection(set<T, C> a, ConstCollection<T> b, C comp)
+  template <typename T>
+  static set<T> set_difference(const ConstCollection<T> &a, const set<T> &b)
   {
-    return set_intersection(b, a, comp);
+    set<T> c;
+    for (const T &e : a)
+    {
+      if (!b.count(e))
+        c.insert(e);
+    }
+    return c;
   }
 
   /**
-   * Computes the difference of two sets `a`and `b`.
+   * Computes the difference of a set `a` and a ConstCollection `b`.
    * Returns `a\b`.
    */
   template <typename T>
-  static set<T> set_difference(set<T> a, set<T> b)
+  static set<T> set_difference(const set<T> &a, const ConstCollection<T> &b)
   {
-    set<T> c;
-    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), inserter(c, c.end()));
+    set<T> c(a);
+    for (const T &e : b)
+      c.erase(e);
     return c;
   }
 
+  /* The same operations on sorted sets, vectors or ranges, into a set or a vector owned by the caller (cleared
+     first, and which must not be one of the operands), or in place. */
+
   /**
-   * Computes the difference of a vector `a` and a set `b`.
-   * Returns `a\b`.
+   * Sets `c` to the union of the sorted `a` and `b`.
    */
-  template <typename T>
-  static set<T> set_difference(vector<T> a, set<T> b)
+  template <typename A, typename B, typename C>
+  static void set_union(const A &a, const B &b, C &c)
   {
-    set<T> c;
-    sort(a.begin(), a.end());
-    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), inserter(c, c.end()));
-    return c;
+    c.clear();
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), inserter(c, c.end()));
   }
 
   /**
-   * Computes the difference of a set `a` and a vector `b`.
-   * Returns `a\b`.
+   * Sets `c` to the intersection of the sorted `a` and `b`.
    */
-  template <typename T>
-  static set<T> set_difference(set<T> a, vector<T> b)
+  template <typename A, typename B, typename C>
+  static void set_intersection(const A &a, const B &b, C &c)
   {
-    set<T> c;
-    sort(b.begin(), b.end());
-    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), inserter(c, c.end()));
-    return c;
+    c.clear();
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), inserter(c, c.end()));
   }
 
   /**
-   * Computes the difference of a ConstCollection `a` and a set `b`.
-   * Returns `a\b`.
+   * Sets `c` to the difference `a\b` of the sorted `a` and `b`.
    */
-  template <typename T>
-  static set<T> set_difference(ConstCollection<T> a, set<T> b) { return set_difference(toSet(a), b); }
+  template <typename A, typename B, typename C>
+  static void set_difference(const A &a, const B &b, C &c)
+  {
+    c.clear();
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), inserter(c, c.end()));
+  }
 
   /**
-   * Computes the difference of a set `a` and a ConstCollection `b`.
-   * Returns `a\b`.
+   * Keeps in the set `a` only the elements of the sorted `b`.
    */
-  template <typename T>
-  static set<T> set_difference(set<T> a, ConstCollection<T> b) { return set_difference(a, toSet(b)); }
+  template <typename T, typename Compare, typename Allocator, typename B>
+  static void intersect_with(set<T, Compare, Allocator> &a, const B &b)
+  {
+    auto j = b.begin();
+    for (auto i = a.begin(); i != a.end();)
+    {
+      while (j != b.end() && *j < *i)
+        ++j;
+      if (j != b.end() && *j == *i)
+        ++i;
+      else
+        i = a.erase(i);
+    }
+  }
 
   /**
-   * Computes the difference of two sets with comparator.
-   * Returns `a\b`.
+   * Keeps in the sorted vector `a` only the elements of the sorted `b`.
    */
-  template <typename T, typename C>
-  static set<T, C> set_difference(set<T, C> a, set<T, C> b, C comp)
+  template <typename T, typename B>
+  static void intersect_with(vector<T> &a, const B &b)
   {
-    set<T, C> c(comp);
-    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), inserter(c, c.end()), comp);
-    return c;
+    auto j = b.begin();
+    size_t kept = 0;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+      while (j != b.end() && *j < a[i])
+        ++j;
+      if (j != b.end() && *j == a[i])
+        a[kept++] = a[i];
+    }
+    a.resize(kept);
   }
 
   /**
-   * Computes the difference of two sets with comparator.
-   * Returns `a\b`.
+   * Removes from the set `a` the elements of the sorted `b`.
    */
-  template <typename T, typename C>
-  static set<T, C> set_difference(set<T, C> a, set<T> b, C comp)
+  template <typename T, typename Compare, typename Allocator, typename B>
+  static void subtract(set<T, Compare, Allocator> &a, const B &b)
   {
-    set<T, C> bBis(comp);
-    for (T e : b)
-      bBis.insert(e);
-    return set_difference(a, bBis, comp);
+    for (const T &e : b)
+      a.erase(e);
   }
 
   /**
-   * Computes the difference of two sets with comparator.
-   * Returns `a\b`.
+   * Removes from the sorted vector `a` the elements of the sorted `b`.
    */
-  template <typename T, typename C>
-  static set<T, C> set_difference(set<T> a, set<T, C> b, C comp)
+  template <typename T, typename B>
+  static void subtract(vector<T> &a, const B &b)
   {
-    set<T, C> aBis(comp);
-    for (T e : a)
-      aBis.insert(e);
-    return set_difference(aBis, b, comp);
+    auto j = b.begin();
+    size_t kept = 0;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+      while (j != b.end() && *j < a[i])
+        ++j;
+      if (j == b.end() || !(*j == a[i]))
+        a[kept++] = a[i];
+    }
+    a.resize(kept);
   }
 
   /**
@@ -653,19 +827,41 @@ public:
     }
   }
 
-  template <typename T, typename C>
-  static void printCurrentState(set<T> &clique, set<T, C> &candidates, set<vertex_t> &excluded)
+  static void printPivot()
+  {
+    printPivot(42);
+  }
+
+  static void printPivot(unsigned int width)
+  {
+    unsigned int length = width - 7;
+    unsigned int remain = LENGTH - width;
+    switch (Globals::pivotValue)
+    {
+    case NO_PIVOT:
+      cout << "c | Pivot:" << setw(length) << "OFF" << setw(remain) << "|" << endl;
+      break;
+    case TOMITA_PIVOT:
+      cout << "c | Pivot:" << setw(length) << "Tomita" << setw(remain) << "|" << endl;
+      break;
+    case DEGREE_PIVOT:
+      cout << "c | Pivot:" << setw(length) << "Degree" << setw(remain) << "|" << endl;
+      break;
+    }
+  }
+
+  static void printCurrentState(const clique_t &clique, SortedRange<vertex_t> candidates, SortedRange<vertex_t> excluded)
   {
     cout << "c | ... current clique (" << clique.size() << ") = {";
-    for (T v : clique)
+    for (vertex_t v : clique)
       cout << " " << v;
     cout << " }" << endl;
     cout << "c | ... candidates (" << candidates.size() << ") = {";
-    for (T v : candidates)
+    for (vertex_t v : candidates)
       cout << " " << v;
     cout << " }" << endl;
     cout << "c | ... excluded (" << excluded.size() << ") = {";
-    for (T v : excluded)
+    for (vertex_t v : excluded)
       cout << " " << v;
     cout << " }" << endl;
     cout << DLINE << endl;